@@ -3,11 +3,34 @@
 #include <windows.h>
 #include <vector>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+#include <algorithm>
 #include <map>
 #include <array>
+#include <tuple>
 #include <iostream>
 #include <cmath>
+#include <cstring>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <iterator>
+#include <type_traits>
+#include <fstream>
 #include <psapi.h>
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define IMH_TARGET(isa)
+#else
+#include <cpuid.h>
+#define IMH_TARGET(isa) __attribute__((target(isa)))
+#endif
 
 #pragma comment(lib, "psapi.lib")
 
@@ -26,940 +49,6161 @@ namespace IMH
 		/* Checks if a pointer is valid */
 		template<typename T>
 		inline bool IsValidPtr(T* p_any) { return p_any != nullptr && IsValidAddr(reinterpret_cast<uintptr_t>(p_any)); }
-	}
 
-	namespace Module
-	{
-		/* Gets the base address of the provided module name*/
-		inline uintptr_t GetMBA(const char* moduleName = nullptr) noexcept
+		/* Index of the lowest set bit (x must be non-zero) */
+		inline unsigned CountTrailingZeros(uint64_t x) noexcept
 		{
-			if (moduleName == nullptr)
-				return reinterpret_cast<uintptr_t>(GetModuleHandleA(NULL));
+#if defined(_MSC_VER) && defined(_WIN64)
+			unsigned long idx;
+			_BitScanForward64(&idx, x);
+			return idx;
+#elif defined(_MSC_VER)
+			unsigned long idx;
+			if (_BitScanForward(&idx, static_cast<unsigned long>(x))) return idx;
+			_BitScanForward(&idx, static_cast<unsigned long>(x >> 32));
+			return idx + 32;
+#else
+			return static_cast<unsigned>(__builtin_ctzll(x));
+#endif
+		}
 
-			return reinterpret_cast<uintptr_t>(GetModuleHandleA(moduleName));
+		/* Number of set bits */
+		inline unsigned PopCount(uint64_t x) noexcept
+		{
+#if defined(_MSC_VER) && defined(_WIN64)
+			return static_cast<unsigned>(__popcnt64(x));
+#elif defined(_MSC_VER)
+			return __popcnt(static_cast<unsigned>(x)) + __popcnt(static_cast<unsigned>(x >> 32));
+#else
+			return static_cast<unsigned>(__builtin_popcountll(x));
+#endif
 		}
-	}
 
-	namespace Utils
-	{
-		/* Reads memory at the provided address */
-		template<typename T>
-		inline T Read(uintptr_t address) noexcept
+		/* SIMD instruction sets usable on this CPU *and* enabled by the OS */
+		struct CpuFeatures
 		{
-			if (!Helpers::IsValidAddr(address))
-				return T();
+			bool sse2 = false;
+			bool ssse3 = false;
+			bool avx2 = false;
+			bool avx512bw = false;
+		};
 
-			DWORD oldProtect;
-			if (!VirtualProtect(reinterpret_cast<void*>(address), sizeof(T), PAGE_EXECUTE_READWRITE, &oldProtect))
-				return T();
+		inline void CpuId(int out[4], int leaf, int subleaf = 0) noexcept
+		{
+#if defined(_MSC_VER)
+			__cpuidex(out, leaf, subleaf);
+#else
+			unsigned a = 0, b = 0, c = 0, d = 0;
+			__cpuid_count(leaf, subleaf, a, b, c, d);
+			out[0] = static_cast<int>(a); out[1] = static_cast<int>(b);
+			out[2] = static_cast<int>(c); out[3] = static_cast<int>(d);
+#endif
+		}
+
+		/* Detected once, then cached */
+		inline const CpuFeatures& GetCpuFeatures() noexcept
+		{
+			static const CpuFeatures features = [] {
+				CpuFeatures f;
+				int r[4] = {};
+				CpuId(r, 0);
+				const int maxLeaf = r[0];
+				if (maxLeaf < 1) return f;
+
+				CpuId(r, 1);
+				f.sse2 = (r[3] & (1 << 26)) != 0;
+				f.ssse3 = (r[2] & (1 << 9)) != 0;
+				const bool osxsave = (r[2] & (1 << 27)) != 0;
+				const bool avx = (r[2] & (1 << 28)) != 0;
+
+				uint64_t xcr0 = 0;
+				if (osxsave) {
+#if defined(_MSC_VER)
+					xcr0 = _xgetbv(0);
+#else
+					uint32_t lo = 0, hi = 0;
+					__asm__ volatile("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+					xcr0 = (static_cast<uint64_t>(hi) << 32) | lo;
+#endif
+				}
+				const bool ymmState = (xcr0 & 0x6) == 0x6;   // XMM + YMM
+				const bool zmmState = (xcr0 & 0xE6) == 0xE6; // + opmask, ZMM_Hi256, Hi16_ZMM
+
+				if (maxLeaf >= 7) {
+					CpuId(r, 7, 0);
+					f.avx2 = avx && ymmState && (r[1] & (1 << 5)) != 0;
+					f.avx512bw = zmmState && (r[1] & (1 << 16)) != 0 && (r[1] & (1 << 30)) != 0;
+				}
+				return f;
+			}();
+			return features;
+		}
 
-			T retValue = NULL;
+		/* Small persistent thread pool; the calling thread takes part in every ParallelFor.
+		   Never create or use one from DllMain: threads started under the loader lock do not run. */
+		class WorkerPool
+		{
+		public:
+			explicit WorkerPool(unsigned threads = 0)
+			{
+				if (threads == 0) {
+					const unsigned hw = std::thread::hardware_concurrency();
+					threads = hw > 1 ? (std::min)(hw - 1, 15u) : 0;
+				}
+				for (unsigned i = 0; i < threads; ++i)
+					workers.emplace_back([this] { WorkerLoop(); });
+				threadCount.store(threads);
+			}
+
+			~WorkerPool() { Shutdown(); }
 
-			try {
-				retValue = *reinterpret_cast<T*>(address);
+			WorkerPool(const WorkerPool&) = delete;
+			WorkerPool& operator=(const WorkerPool&) = delete;
+
+			/* Stops and joins the workers; later ParallelFor calls run on the caller.
+			   Waits for a ParallelFor in flight. Call it outside DllMain, before the module unloads. */
+			void Shutdown()
+			{
+				std::lock_guard<std::mutex> serial(callMx);
+				{
+					std::lock_guard<std::mutex> lg(mx);
+					stopping = true;
+				}
+				cv.notify_all();
+				for (auto& t : workers) t.join();
+				workers.clear();
+				threadCount.store(0);
 			}
-			catch (...)
+
+			/* Threads available to ParallelFor, including the caller */
+			unsigned Size() const noexcept { return threadCount.load() + 1; }
+
+			/* Runs fn(i) for every i in [0, count) and returns once all calls finished.
+			   Calls from inside a pool task run inline instead of deadlocking. */
+			void ParallelFor(size_t count, const std::function<void(size_t)>& fn)
 			{
-				VirtualProtect(reinterpret_cast<void*>(address), sizeof(T), oldProtect, &oldProtect);
-				return T();
+				if (count == 0) return;
+				if (count == 1 || InsideTask()) {
+					for (size_t i = 0; i < count; ++i) fn(i);
+					return;
+				}
+
+				std::unique_lock<std::mutex> serial(callMx);
+				if (workers.empty()) {
+					serial.unlock();
+					for (size_t i = 0; i < count; ++i) fn(i);
+					return;
+				}
+				{
+					std::lock_guard<std::mutex> lg(mx);
+					job = &fn;
+					jobCount = count;
+					next.store(0);
+					active = workers.size();
+					++generation;
+				}
+				cv.notify_all();
+
+				RunTasks(fn, count);
+
+				std::unique_lock<std::mutex> lk(mx);
+				doneCv.wait(lk, [this] { return active == 0; });
+				job = nullptr;
 			}
 
-			VirtualProtect(reinterpret_cast<void*>(address), sizeof(T), oldProtect, &oldProtect);
-		}
+		private:
+			static bool& InsideTask() { thread_local bool inside = false; return inside; }
 
-		/* Writes memory at the provided address */
-		template<typename T>
-		inline bool Write(uintptr_t address, T value) noexcept
-		{
-			if (!Helpers::IsValidAddr(address))
-				return false;
-			DWORD oldProtect;
-			if (!VirtualProtect(reinterpret_cast<void*>(address), sizeof(T), PAGE_EXECUTE_READWRITE, &oldProtect))
-				return false;
-			try {
-				*reinterpret_cast<T*>(address) = value;
+			void RunTasks(const std::function<void(size_t)>& fn, size_t count)
+			{
+				InsideTask() = true;
+				for (size_t i = next.fetch_add(1); i < count; i = next.fetch_add(1))
+					fn(i);
+				InsideTask() = false;
 			}
-			catch (...)
+
+			void WorkerLoop()
 			{
-				VirtualProtect(reinterpret_cast<void*>(address), sizeof(T), oldProtect, &oldProtect);
-				return false;
+				uint64_t seen = 0;
+				for (;;) {
+					const std::function<void(size_t)>* fn = nullptr;
+					size_t count = 0;
+					{
+						std::unique_lock<std::mutex> lk(mx);
+						cv.wait(lk, [&] { return stopping || generation != seen; });
+						if (stopping) return;
+						seen = generation;
+						fn = job;
+						count = jobCount;
+					}
+					RunTasks(*fn, count);
+					{
+						std::lock_guard<std::mutex> lg(mx);
+						if (--active == 0) doneCv.notify_all();
+					}
+				}
 			}
-			VirtualProtect(reinterpret_cast<void*>(address), sizeof(T), oldProtect, &oldProtect);
-			return true;
-		}
 
-		inline uintptr_t FindDMAAddy(uintptr_t ptr, std::vector<unsigned int> offsets) noexcept
+			std::vector<std::thread> workers;
+			std::atomic<unsigned> threadCount{ 0 };
+			std::mutex mx, callMx;
+			std::condition_variable cv, doneCv;
+			const std::function<void(size_t)>* job = nullptr;
+			size_t jobCount = 0;
+			std::atomic<size_t> next{ 0 };
+			size_t active = 0;
+			uint64_t generation = 0;
+			bool stopping = false;
+		};
+
+		/* Bounded single-producer / single-consumer queue, lock-free on both ends.
+		   Capacity is rounded up to a power of two; Push fails instead of overwriting when full. */
+		template <typename T>
+		class SpscRing
 		{
-			if (!ptr || offsets.empty())
-				return 0;
+		public:
+			explicit SpscRing(size_t capacity)
+			{
+				size_t n = 2;
+				while (n < capacity) n <<= 1;
+				m_mask = n - 1;
+				m_items.resize(n);
+			}
 
-			uintptr_t addr = ptr;
+			SpscRing(const SpscRing&) = delete;
+			SpscRing& operator=(const SpscRing&) = delete;
 
-			for (unsigned int i = 0; i < offsets.size(); ++i)
+			/* Producer side */
+			bool Push(const T& item) noexcept
 			{
-				if (IsBadReadPtr(reinterpret_cast<void*>(addr), sizeof(uintptr_t)))
-					return 0;
+				const size_t head = m_head.load(std::memory_order_relaxed);
+				if (head - m_tail.load(std::memory_order_acquire) > m_mask)
+					return false;
+				m_items[head & m_mask] = item;
+				m_head.store(head + 1, std::memory_order_release);
+				return true;
+			}
 
-				addr = *reinterpret_cast<uintptr_t*>(addr);
+			/* Consumer side */
+			bool Pop(T& out) noexcept
+			{
+				const size_t tail = m_tail.load(std::memory_order_relaxed);
+				if (tail == m_head.load(std::memory_order_acquire))
+					return false;
+				out = m_items[tail & m_mask];
+				m_tail.store(tail + 1, std::memory_order_release);
+				return true;
+			}
 
-				if (addr == 0 && i != offsets.size() - 1)
-					return 0;
+			size_t Size() const noexcept { return m_head.load(std::memory_order_acquire) - m_tail.load(std::memory_order_acquire); }
+			size_t Capacity() const noexcept { return m_mask + 1; }
 
-				if (i != offsets.size() - 1)
-					addr += offsets[i];
-				else
-					addr += offsets[i];
-			}
+		private:
+			alignas(64) std::atomic<size_t> m_head{ 0 };
+			alignas(64) std::atomic<size_t> m_tail{ 0 };
+			alignas(64) size_t m_mask = 0;
+			std::vector<T> m_items;
+		};
 
-			return addr;
+		/* Shared pool used by the parallel scanners; created on first use and never destroyed, so no
+		   static destructor joins threads during DLL_PROCESS_DETACH. A DLL that may be unloaded calls
+		   DefaultPool().Shutdown() from its own teardown (not from DllMain) before FreeLibrary. */
+		inline WorkerPool& DefaultPool()
+		{
+			static WorkerPool* pool = new WorkerPool();
+			return *pool;
 		}
 	}
 
-	namespace Opcode
+	namespace Module
 	{
-		/* Writes new opcodes*/
-		inline bool WriteOpcode(uintptr_t address, const std::vector<BYTE>& newBytes) noexcept
+		/* Gets the base address of the provided module name*/
+		inline uintptr_t GetMBA(const char* moduleName = nullptr) noexcept
 		{
-			if (address == 0 || newBytes.empty())
-				return false;
+			if (moduleName == nullptr)
+				return reinterpret_cast<uintptr_t>(GetModuleHandleA(NULL));
 
-			BYTE* dest = reinterpret_cast<BYTE*>(address);
+			return reinterpret_cast<uintptr_t>(GetModuleHandleA(moduleName));
+		}
+	}
 
-			DWORD oldProtect = 0;
-			size_t size = newBytes.size();
+	namespace Memory
+	{
+		/* A run of committed pages; adjacent pages that pass the same filter are merged into one region */
+		struct Region
+		{
+			uintptr_t base = 0;
+			size_t size = 0;
+			DWORD protect = 0;	// protection of the first page in the run
+		};
 
-			// Change memory protection if requested
-			VirtualProtect(dest, size, PAGE_EXECUTE_READWRITE, &oldProtect);
+		/* Which pages GetRegions should keep (flags combine with |) */
+		enum RegionFilter : unsigned
+		{
+			Readable = 1,
+			Writable = 2,
+			Executable = 4
+		};
 
-			// Copy the new bytes
-			std::memcpy(dest, newBytes.data(), size);
+		inline bool IsReadableProtect(DWORD protect) noexcept
+		{
+			if (protect & (PAGE_GUARD | PAGE_NOACCESS)) return false;
+			return (protect & (PAGE_READONLY | PAGE_READWRITE | PAGE_WRITECOPY |
+				PAGE_EXECUTE_READ | PAGE_EXECUTE_READWRITE | PAGE_EXECUTE_WRITECOPY)) != 0;
+		}
 
-			// Restore protection
-			VirtualProtect(dest, size, oldProtect, &oldProtect);
+		inline bool IsWritableProtect(DWORD protect) noexcept
+		{
+			if (protect & (PAGE_GUARD | PAGE_NOACCESS)) return false;
+			return (protect & (PAGE_READWRITE | PAGE_WRITECOPY | PAGE_EXECUTE_READWRITE | PAGE_EXECUTE_WRITECOPY)) != 0;
+		}
 
-			return true;
+		inline bool IsExecutableProtect(DWORD protect) noexcept
+		{
+			if (protect & (PAGE_GUARD | PAGE_NOACCESS)) return false;
+			return (protect & (PAGE_EXECUTE | PAGE_EXECUTE_READ | PAGE_EXECUTE_READWRITE | PAGE_EXECUTE_WRITECOPY)) != 0;
 		}
 
-		inline std::vector<BYTE> ReadOpcode(uintptr_t address, size_t size)
+		inline bool MatchesFilter(DWORD protect, unsigned filter) noexcept
 		{
-			if (address == 0 || size == 0)
-				return {};
+			if ((filter & Readable) && !IsReadableProtect(protect)) return false;
+			if ((filter & Writable) && !IsWritableProtect(protect)) return false;
+			if ((filter & Executable) && !IsExecutableProtect(protect)) return false;
+			return !(protect & (PAGE_GUARD | PAGE_NOACCESS));
+		}
 
-			const BYTE* src = reinterpret_cast<const BYTE*>(address);
+		/* Where Utils reads/writes, GetRegions and the String readers go.
+		   With no backend set (the default) they work on the current process directly, with the
+		   fast paths below. SetBackend(&processBackend) sends the same calls to another process;
+		   call Tick() once per frame so cached pages are re-read. */
+		class Backend
+		{
+		public:
+			virtual ~Backend() = default;
+			virtual bool Read(uintptr_t address, void* out, size_t size) = 0;
+			virtual bool Write(uintptr_t address, const void* data, size_t size) = 0;
+			virtual bool Query(uintptr_t address, MEMORY_BASIC_INFORMATION& mbi) = 0;
+			/* Start of a new frame: drop anything cached */
+			virtual void Tick() {}
+			virtual bool IsLocal() const noexcept { return false; }
+		};
+
+		inline std::atomic<Backend*>& BackendSlot() noexcept
+		{
+			static std::atomic<Backend*> current{ nullptr };
+			return current;
+		}
 
-			std::vector<BYTE> buffer(size);
-			std::memcpy(buffer.data(), src, size);
+		/* The backend in use, nullptr while working on the current process directly */
+		inline Backend* CurrentBackend() noexcept { return BackendSlot().load(std::memory_order_acquire); }
 
-			return buffer;
+		/* Not owned; pass nullptr (or a LocalBackend) to return to the current process */
+		inline void SetBackend(Backend* backend) noexcept
+		{
+			BackendSlot().store(backend && !backend->IsLocal() ? backend : nullptr, std::memory_order_release);
 		}
-	}
 
-    namespace String
-    {
-        // Core string reading functions
-        template <size_t N>
-        bool WriteBuffer(uintptr_t address, const char* newStr, bool protect = true) noexcept
-        {
-            if (!Helpers::IsValidAddr(address) || !newStr)
-                return false;
+		/* Ticks the current backend, if any */
+		inline void Tick()
+		{
+			if (Backend* b = CurrentBackend())
+				b->Tick();
+		}
 
-            char* dest = reinterpret_cast<char*>(address);
-            DWORD oldProtect = 0;
+		/* Installs a backend for the lifetime of the scope */
+		class ScopedBackend
+		{
+		public:
+			explicit ScopedBackend(Backend* backend) noexcept : m_previous(CurrentBackend()) { SetBackend(backend); }
+			~ScopedBackend() { SetBackend(m_previous); }
+			ScopedBackend(const ScopedBackend&) = delete;
+			ScopedBackend& operator=(const ScopedBackend&) = delete;
+
+		private:
+			Backend* m_previous;
+		};
+
+		/* Shared by GetLocalRegions and the backend GetRegions */
+		template <typename QueryFn>
+		inline std::vector<Region> CollectRegions(QueryFn&& query, unsigned filter, uintptr_t start, uintptr_t end)
+		{
+			SYSTEM_INFO si{};
+			GetSystemInfo(&si);
+			const uintptr_t lo = (std::max)(start, reinterpret_cast<uintptr_t>(si.lpMinimumApplicationAddress));
+			const uintptr_t hi = end ? end : reinterpret_cast<uintptr_t>(si.lpMaximumApplicationAddress) + 1;
+
+			std::vector<Region> regions;
+			MEMORY_BASIC_INFORMATION mbi{};
+			for (uintptr_t addr = lo; addr < hi; )
+			{
+				if (!query(addr, mbi) || !mbi.RegionSize)
+					break;
+
+				const uintptr_t rbase = reinterpret_cast<uintptr_t>(mbi.BaseAddress);
+				const uintptr_t rend = rbase + mbi.RegionSize;
+				if (rend <= addr)
+					break;
+
+				if (mbi.State == MEM_COMMIT && MatchesFilter(mbi.Protect, filter))
+				{
+					const uintptr_t b = (std::max)(rbase, lo);
+					const uintptr_t e = (std::min)(rend, hi);
+					if (!regions.empty() && regions.back().base + regions.back().size == b)
+						regions.back().size += e - b;
+					else
+						regions.push_back({ b, e - b, mbi.Protect });
+				}
+				addr = rend;
+			}
+			return regions;
+		}
 
-            if (protect && !VirtualProtect(dest, N, PAGE_EXECUTE_READWRITE, &oldProtect))
-                return false;
+		/* GetRegions for the address space behind a backend */
+		inline std::vector<Region> GetRegions(Backend& backend, unsigned filter = Readable, uintptr_t start = 0, uintptr_t end = 0)
+		{
+			return CollectRegions([&](uintptr_t addr, MEMORY_BASIC_INFORMATION& mbi) { return backend.Query(addr, mbi); }, filter, start, end);
+		}
 
-            try {
-                memset(dest, 0, N);
-                strncpy_s(dest, N, newStr, N - 1);
-                dest[N - 1] = '\0';
-            }
-            catch (...) {
-                if (protect) VirtualProtect(dest, N, oldProtect, &oldProtect);
-                return false;
-            }
+		/* Walks the current process with VirtualQuery and returns the committed regions in [start, end)
+		   whose protection passes the filter; reserved, free, guard and no-access pages are skipped.
+		   Ignores the backend: use this whenever the result is dereferenced as local pointers */
+		inline std::vector<Region> GetLocalRegions(unsigned filter = Readable, uintptr_t start = 0, uintptr_t end = 0)
+		{
+			return CollectRegions([](uintptr_t addr, MEMORY_BASIC_INFORMATION& mbi) {
+				return VirtualQuery(reinterpret_cast<LPCVOID>(addr), &mbi, sizeof(mbi)) != 0;
+			}, filter, start, end);
+		}
 
-            if (protect) VirtualProtect(dest, N, oldProtect, &oldProtect);
-            return true;
-        }
+		/* Same as GetLocalRegions, but follows the current backend when one is set. The addresses
+		   then belong to the other process: only hand them to backend-aware readers (scan_backend,
+		   Utils::Read, ReadMany) */
+		inline std::vector<Region> GetRegions(unsigned filter = Readable, uintptr_t start = 0, uintptr_t end = 0)
+		{
+			if (Backend* b = CurrentBackend())
+				return GetRegions(*b, filter, start, end);
+			return GetLocalRegions(filter, start, end);
+		}
 
-        template <size_t N>
-        std::string ReadBuffer(uintptr_t address) noexcept
-        {
-            if (!Helpers::IsValidAddr(address))
-                return {};
+		/* Same as GetLocalRegions, limited to the image of a module loaded in this process */
+		inline std::vector<Region> GetModuleRegions(HMODULE mod, unsigned filter = Readable | Executable)
+		{
+			MODULEINFO mi{};
+			if (!mod || !GetModuleInformation(GetCurrentProcess(), mod, &mi, sizeof(mi)))
+				return {};
+			const uintptr_t base = reinterpret_cast<uintptr_t>(mi.lpBaseOfDll);
+			return GetLocalRegions(filter, base, base + mi.SizeOfImage);
+		}
 
-            try {
-                const char* src = reinterpret_cast<const char*>(address);
-                char buffer[N + 1] = {};
-                memcpy(buffer, src, N);
-                buffer[N] = '\0';
-                return std::string(buffer);
-            }
-            catch (...) {
-                return {};
-            }
-        }
+		/* Total bytes covered by a region list */
+		inline size_t TotalSize(const std::vector<Region>& regions) noexcept
+		{
+			size_t total = 0;
+			for (const Region& r : regions) total += r.size;
+			return total;
+		}
 
-        // Wide string functions
-        template <size_t N>
-        bool WriteWideBuffer(uintptr_t address, const wchar_t* newStr, bool protect = true) noexcept
-        {
-            if (!Helpers::IsValidAddr(address) || !newStr)
-                return false;
+		/* Process-wide cache of page protections for the hot Read/Write paths.
+		   Direct-mapped and lock-free: one packed 64-bit slot per page, filled by VirtualQuery on
+		   a miss. Entries expire after PageCacheLifetimeMs, or at once after InvalidatePageCache().
+		   A stale entry is never trusted blindly: the copies it allows go through GuardedCopy, and a
+		   fault drops the entry (Forget) so the next call queries the page again.
+		   The syscall-free fast path needs MSVC or clang-cl (SEH-guarded memcpy). Other compilers
+		   (MinGW gcc/clang) skip the VirtualProtect round trip too, but every cached read still
+		   costs one ReadProcessMemory call. */
+		constexpr uint64_t PageCacheLifetimeMs = 250;
+
+		class PageCache
+		{
+		public:
+			enum : uint8_t { Committed = 1, CanRead = 2, CanWrite = 4 };
 
-            wchar_t* dest = reinterpret_cast<wchar_t*>(address);
-            DWORD oldProtect = 0;
-            SIZE_T byteSize = N * sizeof(wchar_t);
+			/* Committed / CanRead / CanWrite flags of the page holding the address */
+			static uint8_t Query(uintptr_t address) noexcept
+			{
+				const uint64_t page = address >> PageShift;
+				const uint64_t stamp = Stamp();
+				std::atomic<uint64_t>& slot = Slots()[(page * 0x9E3779B97F4A7C15ull) >> (64 - SlotBits)];
+				const uint64_t e = slot.load(std::memory_order_relaxed);
+				if ((e & ValidBit) && (e >> PageBitPos) == page && ((e >> StampBitPos) & 0xFFFF) == stamp)
+					return static_cast<uint8_t>(e & 7);
+
+				uint8_t flags = 0;
+				MEMORY_BASIC_INFORMATION mbi{};
+				if (VirtualQuery(reinterpret_cast<LPCVOID>(address), &mbi, sizeof(mbi)) && mbi.State == MEM_COMMIT)
+				{
+					flags |= Committed;
+					if (IsReadableProtect(mbi.Protect)) flags |= CanRead;
+					if (IsWritableProtect(mbi.Protect)) flags |= CanWrite;
+				}
+				slot.store((page << PageBitPos) | (stamp << StampBitPos) | ValidBit | flags, std::memory_order_relaxed);
+				return flags;
+			}
 
-            if (protect && !VirtualProtect(dest, byteSize, PAGE_EXECUTE_READWRITE, &oldProtect))
-                return false;
+			/* True when every page of [address, address + size) has all of the wanted flags */
+			static bool Has(uintptr_t address, size_t size, uint8_t wanted) noexcept
+			{
+				if (!size || address + size < address) return false;
+				const uintptr_t last = (address + size - 1) >> PageShift;
+				for (uintptr_t page = address >> PageShift; page <= last; ++page)
+					if ((Query(page << PageShift) & wanted) != wanted) return false;
+				return true;
+			}
 
-            try {
-                memset(dest, 0, byteSize);
-                wcsncpy_s(dest, N, newStr, N - 1);
-                dest[N - 1] = L'\0';
-            }
-            catch (...) {
-                if (protect) VirtualProtect(dest, byteSize, oldProtect, &oldProtect);
-                return false;
-            }
+			static bool Readable(uintptr_t address, size_t size) noexcept { return Has(address, size, CanRead); }
+			static bool Writable(uintptr_t address, size_t size) noexcept { return Has(address, size, CanWrite); }
 
-            if (protect) VirtualProtect(dest, byteSize, oldProtect, &oldProtect);
-            return true;
-        }
+			static void Invalidate() noexcept { Generation().fetch_add(1, std::memory_order_relaxed); }
 
-        template <size_t N>
-        std::wstring ReadWideBuffer(uintptr_t address) noexcept
-        {
-            if (!Helpers::IsValidAddr(address))
-                return {};
+			/* Drops the entries of the pages of [address, address + size) only */
+			static void Forget(uintptr_t address, size_t size) noexcept
+			{
+				if (!size || address + size < address) return;
+				const uintptr_t last = (address + size - 1) >> PageShift;
+				for (uintptr_t page = address >> PageShift; page <= last; ++page)
+				{
+					std::atomic<uint64_t>& slot = Slots()[(page * 0x9E3779B97F4A7C15ull) >> (64 - SlotBits)];
+					uint64_t e = slot.load(std::memory_order_relaxed);
+					if ((e >> PageBitPos) == page)
+						slot.compare_exchange_strong(e, 0, std::memory_order_relaxed);
+				}
+			}
 
-            try {
-                const wchar_t* src = reinterpret_cast<const wchar_t*>(address);
-                wchar_t buffer[N + 1] = {};
-                wmemcpy(buffer, src, N);
-                buffer[N] = L'\0';
-                return std::wstring(buffer);
-            }
-            catch (...) {
-                return {};
-            }
-        }
+		private:
+			static constexpr unsigned PageShift = 12;
+			static constexpr unsigned SlotBits = 12;
+			// slot layout: flags [0,3) | valid [3] | stamp [4,20) | page number [20,64)
+			static constexpr uint64_t ValidBit = 8;
+			static constexpr unsigned StampBitPos = 4;
+			static constexpr unsigned PageBitPos = 20;
 
-        // Dynamic string reading with safety
-        std::string ReadString(uintptr_t address, size_t maxLength = 256) noexcept
-        {
-            if (!Helpers::IsValidAddr(address))
-                return {};
+			static std::atomic<uint64_t>* Slots() noexcept
+			{
+				static std::atomic<uint64_t> slots[size_t(1) << SlotBits] = {};
+				return slots;
+			}
+			static std::atomic<uint32_t>& Generation() noexcept
+			{
+				static std::atomic<uint32_t> generation{ 0 };
+				return generation;
+			}
+			static uint64_t Stamp() noexcept
+			{
+				return (Generation().load(std::memory_order_relaxed) + GetTickCount64() / PageCacheLifetimeMs) & 0xFFFF;
+			}
+		};
+
+		/* Drops every cached page protection */
+		inline void InvalidatePageCache() noexcept { PageCache::Invalidate(); }
+
+		/* memcpy that reports a fault instead of raising it: when a page was freed or reprotected
+		   after it was checked, it returns false rather than taking the process down. MSVC/clang-cl
+		   use SEH in a function of its own (__try cannot share a frame with objects that unwind): a
+		   plain memcpy unless it faults. Other compilers have no __try, so they copy through
+		   ReadProcessMemory on the current process, which fails the same way but is a syscall. */
+#if defined(_MSC_VER)
+		__declspec(noinline) inline bool GuardedCopy(void* dst, const void* src, size_t size) noexcept
+		{
+			__try
+			{
+				std::memcpy(dst, src, size);
+				return true;
+			}
+			__except (GetExceptionCode() == EXCEPTION_ACCESS_VIOLATION || GetExceptionCode() == EXCEPTION_IN_PAGE_ERROR ||
+				GetExceptionCode() == EXCEPTION_GUARD_PAGE ? EXCEPTION_EXECUTE_HANDLER : EXCEPTION_CONTINUE_SEARCH)
+			{
+				return false;
+			}
+		}
+#else
+		inline bool GuardedCopy(void* dst, const void* src, size_t size) noexcept
+		{
+			SIZE_T copied = 0;
+			return ReadProcessMemory(GetCurrentProcess(), src, dst, size, &copied) && copied == size;
+		}
+#endif
 
-            try {
-                const char* ptr = reinterpret_cast<const char*>(address);
+		/* True when [base, base + size) is committed and readable right now (uncached: a few VirtualQuery
+		   calls for a whole range, meant for re-checking blocks cut from an earlier GetRegions) */
+		inline bool IsRangeReadable(uintptr_t base, size_t size) noexcept
+		{
+			MEMORY_BASIC_INFORMATION mbi{};
+			for (uintptr_t addr = base; addr < base + size; )
+			{
+				if (!VirtualQuery(reinterpret_cast<LPCVOID>(addr), &mbi, sizeof(mbi)) || mbi.State != MEM_COMMIT || !IsReadableProtect(mbi.Protect))
+					return false;
+				addr = reinterpret_cast<uintptr_t>(mbi.BaseAddress) + mbi.RegionSize;
+			}
+			return true;
+		}
 
-                // Find actual length safely
-                size_t actualLength = 0;
-                for (size_t i = 0; i < maxLength; ++i) {
-                    if (IsBadReadPtr(ptr + i, 1))
-                        break;
+		/* In-process read used by Utils::Read: readable pages (per PageCache) are copied directly; only
+		   committed pages without read access go through the VirtualProtect round trip */
+		inline bool ReadLocal(uintptr_t address, void* out, size_t size) noexcept
+		{
+			if (PageCache::Readable(address, size))
+			{
+				if (GuardedCopy(out, reinterpret_cast<const void*>(address), size))
+					return true;
+				PageCache::Forget(address, size); // stale entry: query again below
+			}
+			if (!PageCache::Has(address, size, PageCache::Committed))
+				return false;
 
-                    if (ptr[i] == '\0') {
-                        actualLength = i;
-                        break;
-                    }
-                    actualLength = i + 1;
-                }
+			DWORD oldProtect;
+			if (!VirtualProtect(reinterpret_cast<void*>(address), size, PAGE_EXECUTE_READWRITE, &oldProtect))
+				return false;
 
-                return actualLength > 0 ? std::string(ptr, actualLength) : std::string{};
-            }
-            catch (...) {
-                return {};
+			const bool ok = GuardedCopy(out, reinterpret_cast<const void*>(address), size);
+			VirtualProtect(reinterpret_cast<void*>(address), size, oldProtect, &oldProtect);
+			return ok;
+		}
+
+		/* In-process write used by Utils::Write; protection is only changed for pages that are not writable */
+		inline bool WriteLocal(uintptr_t address, const void* data, size_t size) noexcept
+		{
+			if (PageCache::Writable(address, size))
+			{
+				if (GuardedCopy(reinterpret_cast<void*>(address), data, size))
+					return true;
+				PageCache::Forget(address, size); // stale entry: query again below
+			}
+			if (!PageCache::Has(address, size, PageCache::Committed))
+				return false;
+			DWORD oldProtect;
+			if (!VirtualProtect(reinterpret_cast<void*>(address), size, PAGE_EXECUTE_READWRITE, &oldProtect))
+				return false;
+			const bool ok = GuardedCopy(reinterpret_cast<void*>(address), data, size);
+			VirtualProtect(reinterpret_cast<void*>(address), size, oldProtect, &oldProtect);
+			return ok;
+		}
+
+		/* Plain read without any protection change: the current backend, or readable local pages only.
+		   Used where a failed read is an answer (pointer walks, string scans), not an error. */
+		inline bool ReadBytes(uintptr_t address, void* out, size_t size) noexcept
+		{
+			if (Backend* b = CurrentBackend())
+				return b->Read(address, out, size);
+			if (!PageCache::Readable(address, size))
+				return false;
+			if (GuardedCopy(out, reinterpret_cast<const void*>(address), size))
+				return true;
+			PageCache::Forget(address, size);
+			return false;
+		}
+
+		/* The current process, as a Backend */
+		class LocalBackend : public Backend
+		{
+		public:
+			bool Read(uintptr_t address, void* out, size_t size) override { return ReadLocal(address, out, size); }
+			bool Write(uintptr_t address, const void* data, size_t size) override { return WriteLocal(address, data, size); }
+			bool Query(uintptr_t address, MEMORY_BASIC_INFORMATION& mbi) override
+			{
+				return VirtualQuery(reinterpret_cast<LPCVOID>(address), &mbi, sizeof(mbi)) != 0;
+			}
+			void Tick() override { InvalidatePageCache(); }
+			bool IsLocal() const noexcept override { return true; }
+		};
+
+		/* Another process through ReadProcessMemory / WriteProcessMemory / VirtualQueryEx.
+		   Small reads are served from a page cache (up to cachePages 4 KiB pages, refilled from
+		   scratch when full) so walking a struct or a pointer chain costs one call per page, not
+		   per field; Tick() empties it, so call it once per frame. Larger reads bypass the cache.
+		   Safe to share between threads. */
+		class ProcessBackend : public Backend
+		{
+		public:
+			/* The handle needs PROCESS_VM_READ | PROCESS_VM_WRITE | PROCESS_VM_OPERATION |
+			   PROCESS_QUERY_INFORMATION for everything to work; it is not closed */
+			explicit ProcessBackend(HANDLE process, size_t cachePages = 1024)
+				: m_process(process), m_cachePages(cachePages), m_pages(cachePages * PageSize) {}
+
+			/* Opens the process and closes the handle again on destruction */
+			explicit ProcessBackend(DWORD processId, size_t cachePages = 1024)
+				: ProcessBackend(OpenProcess(PROCESS_VM_READ | PROCESS_VM_WRITE | PROCESS_VM_OPERATION | PROCESS_QUERY_INFORMATION, FALSE, processId), cachePages)
+			{
+				m_owned = true;
+			}
+
+			~ProcessBackend() override
+			{
+				if (CurrentBackend() == this)
+					SetBackend(nullptr);
+				if (m_owned && m_process)
+					CloseHandle(m_process);
+			}
+
+			ProcessBackend(const ProcessBackend&) = delete;
+			ProcessBackend& operator=(const ProcessBackend&) = delete;
+
+			bool Valid() const noexcept { return m_process != nullptr; }
+			HANDLE Handle() const noexcept { return m_process; }
+
+			bool Read(uintptr_t address, void* out, size_t size) override
+			{
+				if (!size)
+					return true;
+				if (!m_cachePages || size > 2 * PageSize)
+					return ReadDirect(address, out, size);
+
+				std::lock_guard<std::mutex> lg(m_mx);
+				uint8_t* dst = static_cast<uint8_t*>(out);
+				for (uintptr_t addr = address; addr < address + size; )
+				{
+					const uintptr_t page = addr / PageSize;
+					const uint8_t* src = CachedPage(page);
+					if (!src)
+						return false;
+					const size_t at = addr - page * PageSize;
+					const size_t n = (std::min)(PageSize - at, static_cast<size_t>(address + size - addr));
+					std::memcpy(dst, src + at, n);
+					dst += n;
+					addr += n;
+				}
+				return true;
+			}
+
+			bool Write(uintptr_t address, const void* data, size_t size) override
+			{
+				if (!size)
+					return true;
+
+				SIZE_T written = 0;
+				bool ok = WriteProcessMemory(m_process, reinterpret_cast<LPVOID>(address), data, size, &written) && written == size;
+				if (!ok)
+				{
+					DWORD oldProtect = 0;
+					if (VirtualProtectEx(m_process, reinterpret_cast<LPVOID>(address), size, PAGE_EXECUTE_READWRITE, &oldProtect))
+					{
+						ok = WriteProcessMemory(m_process, reinterpret_cast<LPVOID>(address), data, size, &written) && written == size;
+						VirtualProtectEx(m_process, reinterpret_cast<LPVOID>(address), size, oldProtect, &oldProtect);
+					}
+				}
+
+				std::lock_guard<std::mutex> lg(m_mx);
+				for (uintptr_t page = address / PageSize; page <= (address + size - 1) / PageSize; ++page)
+					m_index.erase(page);
+				return ok;
+			}
+
+			bool Query(uintptr_t address, MEMORY_BASIC_INFORMATION& mbi) override
+			{
+				return VirtualQueryEx(m_process, reinterpret_cast<LPCVOID>(address), &mbi, sizeof(mbi)) == sizeof(mbi);
+			}
+
+			void Tick() override
+			{
+				std::lock_guard<std::mutex> lg(m_mx);
+				m_index.clear();
+				m_used = 0;
+			}
+
+		private:
+			static constexpr size_t PageSize = 4096;
+
+			bool ReadDirect(uintptr_t address, void* out, size_t size) noexcept
+			{
+				SIZE_T got = 0;
+				return ReadProcessMemory(m_process, reinterpret_cast<LPCVOID>(address), out, size, &got) && got == size;
+			}
+
+			/* Page contents, read on a miss; nullptr when the page is not readable */
+			const uint8_t* CachedPage(uintptr_t page)
+			{
+				auto it = m_index.find(page);
+				if (it != m_index.end())
+					return m_pages.data() + it->second * PageSize;
+
+				if (m_used == m_cachePages)
+				{
+					m_index.clear();
+					m_used = 0;
+				}
+				uint8_t* slot = m_pages.data() + m_used * PageSize;
+				if (!ReadDirect(page * PageSize, slot, PageSize))
+					return nullptr;
+				m_index.emplace(page, m_used++);
+				return slot;
+			}
+
+			HANDLE m_process;
+			bool m_owned = false;
+			size_t m_cachePages;
+			std::vector<uint8_t> m_pages;
+			std::unordered_map<uintptr_t, size_t> m_index;	// page number → slot in m_pages
+			size_t m_used = 0;
+			std::mutex m_mx;
+		};
+
+		/* What FirstScan / NextScan keep */
+		enum class ScanCompare : uint8_t
+		{
+			Exact,		// value == a
+			Range,		// a <= value <= b
+			Unknown,	// keep everything (a next scan only refreshes the stored values)
+			Changed,	// the rest compare against the value seen by the previous scan
+			Unchanged,
+			Increased,
+			Decreased
+		};
+
+		template <typename T> struct ValueVector { using Type = __m256i; };
+		template <> struct ValueVector<float> { using Type = __m256; };
+		template <> struct ValueVector<double> { using Type = __m256d; };
+
+		/* AVX2 lane helpers for the value scanner, one lane per T */
+		template <typename T>
+		struct ValueLanes
+		{
+			static constexpr size_t Count = 32 / sizeof(T);
+			static constexpr uint32_t Full = Count == 32 ? 0xFFFFFFFFu : (1u << Count) - 1;
+			using Vec = typename ValueVector<T>::Type;
+
+			IMH_TARGET("avx2") static Vec Load(const T* p) noexcept
+			{
+				if constexpr (std::is_same_v<T, float>) return _mm256_loadu_ps(p);
+				else if constexpr (std::is_same_v<T, double>) return _mm256_loadu_pd(p);
+				else return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+			}
+
+			IMH_TARGET("avx2") static Vec Splat(T v) noexcept
+			{
+				if constexpr (std::is_same_v<T, float>) return _mm256_set1_ps(v);
+				else if constexpr (std::is_same_v<T, double>) return _mm256_set1_pd(v);
+				else if constexpr (sizeof(T) == 1) return _mm256_set1_epi8(static_cast<char>(v));
+				else if constexpr (sizeof(T) == 2) return _mm256_set1_epi16(static_cast<short>(v));
+				else if constexpr (sizeof(T) == 4) return _mm256_set1_epi32(static_cast<int>(v));
+				else return _mm256_set1_epi64x(static_cast<long long>(v));
+			}
+
+			/* Lanes where a == b */
+			IMH_TARGET("avx2") static Vec Eq(Vec a, Vec b) noexcept
+			{
+				if constexpr (std::is_same_v<T, float>) return _mm256_cmp_ps(a, b, _CMP_EQ_OQ);
+				else if constexpr (std::is_same_v<T, double>) return _mm256_cmp_pd(a, b, _CMP_EQ_OQ);
+				else if constexpr (sizeof(T) == 1) return _mm256_cmpeq_epi8(a, b);
+				else if constexpr (sizeof(T) == 2) return _mm256_cmpeq_epi16(a, b);
+				else if constexpr (sizeof(T) == 4) return _mm256_cmpeq_epi32(a, b);
+				else return _mm256_cmpeq_epi64(a, b);
+			}
+
+			/* Lanes where a > b */
+			IMH_TARGET("avx2") static Vec Gt(Vec a, Vec b) noexcept
+			{
+				if constexpr (std::is_same_v<T, float>) return _mm256_cmp_ps(a, b, _CMP_GT_OQ);
+				else if constexpr (std::is_same_v<T, double>) return _mm256_cmp_pd(a, b, _CMP_GT_OQ);
+				else if constexpr (sizeof(T) == 1) return _mm256_cmpgt_epi8(a, b);
+				else if constexpr (sizeof(T) == 2) return _mm256_cmpgt_epi16(a, b);
+				else if constexpr (sizeof(T) == 4) return _mm256_cmpgt_epi32(a, b);
+				else return _mm256_cmpgt_epi64(a, b);
+			}
+
+			/* Lanes outside [lo, hi]; NaN counts as outside */
+			IMH_TARGET("avx2") static Vec Outside(Vec v, Vec lo, Vec hi) noexcept
+			{
+				if constexpr (std::is_same_v<T, float>) return _mm256_or_ps(_mm256_cmp_ps(v, lo, _CMP_NGE_UQ), _mm256_cmp_ps(v, hi, _CMP_NLE_UQ));
+				else if constexpr (std::is_same_v<T, double>) return _mm256_or_pd(_mm256_cmp_pd(v, lo, _CMP_NGE_UQ), _mm256_cmp_pd(v, hi, _CMP_NLE_UQ));
+				else return _mm256_or_si256(Gt(lo, v), Gt(v, hi));
+			}
+
+			/* One bit per lane */
+			IMH_TARGET("avx2") static uint32_t Bits(Vec m) noexcept
+			{
+				if constexpr (std::is_same_v<T, float>) return static_cast<uint32_t>(_mm256_movemask_ps(m));
+				else if constexpr (std::is_same_v<T, double>) return static_cast<uint32_t>(_mm256_movemask_pd(m));
+				else if constexpr (sizeof(T) == 1) return static_cast<uint32_t>(_mm256_movemask_epi8(m));
+				else if constexpr (sizeof(T) == 2)
+				{
+					// movemask_epi8 yields two equal bits per lane; keep the even ones
+					uint32_t x = static_cast<uint32_t>(_mm256_movemask_epi8(m)) & 0x55555555u;
+					x = (x | (x >> 1)) & 0x33333333u;
+					x = (x | (x >> 2)) & 0x0F0F0F0Fu;
+					x = (x | (x >> 4)) & 0x00FF00FFu;
+					return (x | (x >> 8)) & 0xFFFFu;
+				}
+				else if constexpr (sizeof(T) == 4) return static_cast<uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(m)));
+				else return static_cast<uint32_t>(_mm256_movemask_pd(_mm256_castsi256_pd(m)));
+			}
+		};
+
+		/* Scalar form of every ScanCompare; lo/hi for Exact/Range, prev for the relative ones */
+		template <typename T>
+		inline bool ValueMatches(ScanCompare compare, T cur, T prev, T lo, T hi) noexcept
+		{
+			switch (compare)
+			{
+			case ScanCompare::Exact:
+			case ScanCompare::Range:     return cur >= lo && cur <= hi;
+			case ScanCompare::Unknown:   return true;
+			case ScanCompare::Changed:   return !(cur == prev);
+			case ScanCompare::Unchanged: return cur == prev;
+			case ScanCompare::Increased: return cur > prev;
+			case ScanCompare::Decreased: return cur < prev;
+			}
+			return false;
+		}
+
+		template <typename T>
+		IMH_TARGET("avx2")
+		inline size_t MatchRangeAvx2(const T* data, size_t n, T lo, T hi, uint64_t* out) noexcept
+		{
+			using L = ValueLanes<T>;
+			const auto vlo = L::Splat(lo), vhi = L::Splat(hi);
+			size_t i = 0;
+			for (; i + L::Count <= n; i += L::Count)
+			{
+				const uint32_t hit = ~L::Bits(L::Outside(L::Load(data + i), vlo, vhi)) & L::Full;
+				out[i / 64] |= uint64_t(hit) << (i % 64);
+			}
+			return i;
+		}
+
+		template <typename T>
+		IMH_TARGET("avx2")
+		inline size_t MatchRelationAvx2(const T* cur, const T* prev, size_t n, ScanCompare compare, uint64_t* out) noexcept
+		{
+			using L = ValueLanes<T>;
+			size_t i = 0;
+			for (; i + L::Count <= n; i += L::Count)
+			{
+				const auto c = L::Load(cur + i), p = L::Load(prev + i);
+				uint32_t hit = 0;
+				switch (compare)
+				{
+				case ScanCompare::Changed:   hit = ~L::Bits(L::Eq(c, p)) & L::Full; break;
+				case ScanCompare::Unchanged: hit = L::Bits(L::Eq(c, p)); break;
+				case ScanCompare::Increased: hit = L::Bits(L::Gt(c, p)); break;
+				case ScanCompare::Decreased: hit = L::Bits(L::Gt(p, c)); break;
+				default: return i;
+				}
+				out[i / 64] |= uint64_t(hit) << (i % 64);
+			}
+			return i;
+		}
+
+		/* Sets bit i of out for every data[i] in [lo, hi]; out must hold (n + 63) / 64 zeroed words */
+		template <typename T>
+		inline void MatchRange(const T* data, size_t n, T lo, T hi, uint64_t* out) noexcept
+		{
+			size_t i = Helpers::GetCpuFeatures().avx2 ? MatchRangeAvx2(data, n, lo, hi, out) : 0;
+			for (; i < n; ++i)
+				if (data[i] >= lo && data[i] <= hi)
+					out[i / 64] |= uint64_t(1) << (i % 64);
+		}
+
+		/* Sets bit i of out when cur[i] relates to prev[i] as compare (Changed..Decreased) asks */
+		template <typename T>
+		inline void MatchRelation(const T* cur, const T* prev, size_t n, ScanCompare compare, uint64_t* out) noexcept
+		{
+			size_t i = Helpers::GetCpuFeatures().avx2 ? MatchRelationAvx2(cur, prev, n, compare, out) : 0;
+			for (; i < n; ++i)
+				if (ValueMatches(compare, cur[i], prev[i], T(), T()))
+					out[i / 64] |= uint64_t(1) << (i % 64);
+		}
+
+		/* In-process value scanner (first scan / next scan) over committed memory, writable by default.
+		   Candidates are naturally aligned T slots. The scanned range is cut into 1 MiB blocks that run on
+		   Helpers::DefaultPool(); each block keeps its candidates as a bitset or as varint slot deltas,
+		   whichever is smaller, plus the value the last scan saw (nothing at all after an Exact scan,
+		   where every candidate holds the searched value). An Unknown first scan has to snapshot the
+		   whole range, so it costs as much memory as it covers until the next scan narrows it.
+		   A relative compare (Changed..Decreased) in FirstScan behaves like Unknown. */
+		template <typename T>
+		class ValueScanner
+		{
+			static_assert(std::is_same_v<T, int8_t> || std::is_same_v<T, int16_t> || std::is_same_v<T, int32_t> ||
+				std::is_same_v<T, int64_t> || std::is_same_v<T, float> || std::is_same_v<T, double>,
+				"ValueScanner supports int8_t..int64_t, float and double");
+
+		public:
+			explicit ValueScanner(unsigned filter = Readable | Writable, uintptr_t start = 0, uintptr_t end = 0)
+				: m_filter(filter), m_start(start), m_end(end) {}
+
+			/* Scans every region again from scratch; returns the number of candidates */
+			size_t FirstScan(ScanCompare compare, T value = T(), T upper = T())
+			{
+				if (compare != ScanCompare::Exact && compare != ScanCompare::Range)
+					compare = ScanCompare::Unknown;
+
+				m_blocks.clear();
+				for (const Region& r : GetLocalRegions(m_filter, m_start, m_end))
+				{
+					const uintptr_t end = r.base + r.size;
+					for (uintptr_t b = (r.base + sizeof(T) - 1) & ~uintptr_t(sizeof(T) - 1); b + sizeof(T) <= end; b += BlockBytes)
+					{
+						Block blk;
+						blk.base = b;
+						blk.slots = (std::min)(BlockBytes, static_cast<size_t>(end - b)) / sizeof(T);
+						m_blocks.push_back(std::move(blk));
+					}
+				}
+
+				const T lo = value, hi = compare == ScanCompare::Range ? upper : value;
+				Helpers::DefaultPool().ParallelFor(m_blocks.size(), [&](size_t i) {
+					Block& blk = m_blocks[i];
+					const T* data = Snapshot(blk);
+					if (!data)
+						return;
+					if (compare == ScanCompare::Unknown)
+					{
+						blk.store = Store::All;
+						blk.values.assign(data, data + blk.slots);
+						blk.count = blk.slots;
+						return;
+					}
+					std::vector<uint64_t> hits((blk.slots + 63) / 64);
+					MatchRange(data, blk.slots, lo, hi, hits.data());
+					Keep(blk, hits, data, compare == ScanCompare::Exact, value);
+				});
+
+				m_started = true;
+				return Compact();
+			}
+
+			/* Narrows the current candidates; Exact/Range compare against value/upper, the relative
+			   compares against the previous scan. Runs FirstScan when nothing was scanned yet. */
+			size_t NextScan(ScanCompare compare, T value = T(), T upper = T())
+			{
+				if (!m_started)
+					return FirstScan(compare, value, upper);
+
+				const T lo = value, hi = compare == ScanCompare::Range ? upper : value;
+				const bool relative = compare != ScanCompare::Exact && compare != ScanCompare::Range && compare != ScanCompare::Unknown;
+				Helpers::DefaultPool().ParallelFor(m_blocks.size(), [&](size_t i) {
+					Block& blk = m_blocks[i];
+					const T* data = Snapshot(blk);
+					if (!data)
+					{
+						Drop(blk);
+						return;
+					}
+
+					std::vector<uint64_t> hits((blk.slots + 63) / 64);
+					if (blk.store == Store::All)
+					{
+						if (compare == ScanCompare::Unknown)
+						{
+							blk.values.assign(data, data + blk.slots);
+							return;
+						}
+						if (relative)
+							MatchRelation(data, blk.values.data(), blk.slots, compare, hits.data());
+						else
+							MatchRange(data, blk.slots, lo, hi, hits.data());
+					}
+					else
+					{
+						ForEachSlot(blk, [&](size_t slot, size_t idx) {
+							if (ValueMatches(compare, data[slot], Previous(blk, idx), lo, hi))
+								hits[slot / 64] |= uint64_t(1) << (slot % 64);
+						});
+					}
+					Keep(blk, hits, data, compare == ScanCompare::Exact, value);
+				});
+
+				return Compact();
+			}
+
+			bool Started() const noexcept { return m_started; }
+
+			size_t Count() const noexcept
+			{
+				size_t total = 0;
+				for (const Block& blk : m_blocks) total += blk.count;
+				return total;
+			}
+
+			/* Bytes held for candidates and stored values */
+			size_t MemoryUsage() const noexcept
+			{
+				size_t total = m_blocks.capacity() * sizeof(Block);
+				for (const Block& blk : m_blocks)
+					total += blk.bits.capacity() * sizeof(uint64_t) + blk.deltas.capacity() + blk.values.capacity() * sizeof(T);
+				return total;
+			}
+
+			/* fn(address, value seen by the last scan) for every candidate, in address order */
+			template <typename F>
+			void ForEach(F&& fn) const
+			{
+				for (const Block& blk : m_blocks)
+					ForEachSlot(blk, [&](size_t slot, size_t idx) { fn(blk.base + slot * sizeof(T), Previous(blk, idx)); });
+			}
+
+			std::vector<uintptr_t> Addresses(size_t max = SIZE_MAX) const
+			{
+				std::vector<uintptr_t> out;
+				for (const Block& blk : m_blocks)
+				{
+					if (out.size() >= max) break;
+					ForEachSlot(blk, [&](size_t slot, size_t) { if (out.size() < max) out.push_back(blk.base + slot * sizeof(T)); });
+				}
+				return out;
+			}
+
+			void Reset() noexcept
+			{
+				m_blocks.clear();
+				m_blocks.shrink_to_fit();
+				m_started = false;
+			}
+
+		private:
+			static constexpr size_t BlockBytes = size_t(1) << 20;
+
+			enum class Store : uint8_t { All, Bits, Deltas };
+
+			struct Block
+			{
+				uintptr_t base = 0;
+				size_t slots = 0;
+				size_t count = 0;
+				Store store = Store::Bits;
+				bool uniform = false;		// every candidate holds uniformValue, values is empty
+				T uniformValue = T();
+				std::vector<uint64_t> bits;	// Store::Bits: one bit per slot
+				std::vector<uint8_t> deltas;	// Store::Deltas: LEB128 gaps between candidate slots
+				std::vector<T> values;		// one per candidate in slot order (every slot for Store::All)
+			};
+
+			static T Previous(const Block& blk, size_t idx) noexcept { return blk.uniform ? blk.uniformValue : blk.values[idx]; }
+
+			/* The block's current contents copied into a per-thread buffer, nullptr when any of it is
+			   unreadable. The copy is guarded: heap pages decommitted between the check and the read
+			   make it fail instead of faulting. */
+			static const T* Snapshot(const Block& blk)
+			{
+				thread_local std::vector<T> scratch;
+				if (!IsRangeReadable(blk.base, blk.slots * sizeof(T)))
+					return nullptr;
+				if (scratch.size() < blk.slots)
+					scratch.resize(BlockBytes / sizeof(T));
+				if (!GuardedCopy(scratch.data(), reinterpret_cast<const void*>(blk.base), blk.slots * sizeof(T)))
+					return nullptr;
+				return scratch.data();
+			}
+
+			/* fn(slot, candidate index) in slot order */
+			template <typename F>
+			static void ForEachSlot(const Block& blk, F&& fn)
+			{
+				if (!blk.count)
+					return;
+				switch (blk.store)
+				{
+				case Store::All:
+					for (size_t s = 0; s < blk.slots; ++s) fn(s, s);
+					break;
+				case Store::Bits:
+				{
+					size_t idx = 0;
+					for (size_t w = 0; w < blk.bits.size(); ++w)
+						for (uint64_t m = blk.bits[w]; m; m &= m - 1)
+							fn(w * 64 + Helpers::CountTrailingZeros(m), idx++);
+					break;
+				}
+				case Store::Deltas:
+				{
+					size_t slot = 0, pos = 0;
+					for (size_t idx = 0; idx < blk.count; ++idx)
+					{
+						size_t delta = 0;
+						for (unsigned shift = 0; ; shift += 7)
+						{
+							const uint8_t b = blk.deltas[pos++];
+							delta |= size_t(b & 0x7F) << shift;
+							if (!(b & 0x80)) break;
+						}
+						slot += delta;
+						fn(slot, idx);
+					}
+					break;
+				}
+				}
+			}
+
+			static void Drop(Block& blk)
+			{
+				blk.count = 0;
+				blk.bits = {};
+				blk.deltas = {};
+				blk.values = {};
+			}
+
+			/* Makes the set bits of hits the block's candidates, storing their current values from data */
+			static void Keep(Block& blk, std::vector<uint64_t>& hits, const T* data, bool exact, T value)
+			{
+				size_t count = 0;
+				for (uint64_t w : hits) count += Helpers::PopCount(w);
+				Drop(blk);
+				if (!count)
+					return;
+
+				blk.count = count;
+				blk.uniform = exact;
+				blk.uniformValue = value;
+				if (!exact)
+				{
+					blk.values.reserve(count);
+					for (size_t w = 0; w < hits.size(); ++w)
+						for (uint64_t m = hits[w]; m; m &= m - 1)
+							blk.values.push_back(data[w * 64 + Helpers::CountTrailingZeros(m)]);
+				}
+
+				// a delta costs 1-3 bytes, so only encode when that can beat the bitset
+				if (count * 3 < hits.size() * sizeof(uint64_t))
+				{
+					blk.store = Store::Deltas;
+					size_t prev = 0;
+					for (size_t w = 0; w < hits.size(); ++w)
+						for (uint64_t m = hits[w]; m; m &= m - 1)
+						{
+							const size_t slot = w * 64 + Helpers::CountTrailingZeros(m);
+							for (size_t d = slot - prev; ; d >>= 7)
+							{
+								if (d < 0x80) { blk.deltas.push_back(static_cast<uint8_t>(d)); break; }
+								blk.deltas.push_back(static_cast<uint8_t>(d | 0x80));
+							}
+							prev = slot;
+						}
+					blk.deltas.shrink_to_fit();
+				}
+				else
+				{
+					blk.store = Store::Bits;
+					blk.bits = std::move(hits);
+				}
+			}
+
+			/* Drops empty blocks; returns the candidate count */
+			size_t Compact()
+			{
+				m_blocks.erase(std::remove_if(m_blocks.begin(), m_blocks.end(), [](const Block& b) { return !b.count; }), m_blocks.end());
+				return Count();
+			}
+
+			unsigned m_filter;
+			uintptr_t m_start, m_end;
+			std::vector<Block> m_blocks;
+			bool m_started = false;
+		};
+	}
+
+	namespace Utils
+	{
+		/* Reads memory at the provided address (through the current Memory backend, if one is set).
+		   Readable pages (per Memory::PageCache) are read directly; only committed pages without
+		   read access go through the VirtualProtect round trip. */
+		template<typename T>
+		inline T Read(uintptr_t address) noexcept
+		{
+			if (!Helpers::IsValidAddr(address))
+				return T();
+
+			T retValue{};
+			if (Memory::Backend* backend = Memory::CurrentBackend())
+				return backend->Read(address, &retValue, sizeof(T)) ? retValue : T();
+			return Memory::ReadLocal(address, &retValue, sizeof(T)) ? retValue : T();
+		}
+
+		/* Writes memory at the provided address (through the current Memory backend, if one is set).
+		   Writable pages are written directly; protection is only changed for the others. */
+		template<typename T>
+		inline bool Write(uintptr_t address, T value) noexcept
+		{
+			if (!Helpers::IsValidAddr(address))
+				return false;
+			if (Memory::Backend* backend = Memory::CurrentBackend())
+				return backend->Write(address, &value, sizeof(T));
+			return Memory::WriteLocal(address, &value, sizeof(T));
+		}
+
+		/* One entry of a batched read: size bytes at address go to buffer + offset */
+		struct ReadRequest
+		{
+			uintptr_t address = 0;
+			size_t size = 0;
+			size_t offset = 0;
+		};
+
+		/* Bit i of a ReadMany success mask */
+		inline bool ReadSucceeded(const std::vector<uint64_t>& succeeded, size_t i) noexcept
+		{
+			return i / 64 < succeeded.size() && ((succeeded[i / 64] >> (i % 64)) & 1);
+		}
+
+		/* Reads many small fields (e.g. a per-frame entity snapshot) into one caller-provided buffer.
+		   Each touched page is checked once per batch through Memory::PageCache and nothing is
+		   reprotected; a failed entry is zero-filled and its bit in succeeded stays clear.
+		   With a Memory backend set each entry is read through it instead (ProcessBackend serves
+		   them from its page cache). Returns how many entries were read. */
+		inline size_t ReadMany(const ReadRequest* requests, size_t count, void* buffer, size_t bufferSize, std::vector<uint64_t>& succeeded)
+		{
+			succeeded.assign((count + 63) / 64, 0);
+			uint8_t* out = static_cast<uint8_t*>(buffer);
+			Memory::Backend* backend = Memory::CurrentBackend();
+			uintptr_t lastPage = UINTPTR_MAX;
+			bool lastReadable = false;
+			size_t done = 0;
+
+			for (size_t i = 0; i < count; ++i)
+			{
+				const ReadRequest& r = requests[i];
+				if (!out || !r.size || r.offset > bufferSize || r.size > bufferSize - r.offset)
+					continue;
+
+				if (backend)
+				{
+					if (Helpers::IsValidAddr(r.address) && backend->Read(r.address, out + r.offset, r.size))
+					{
+						succeeded[i / 64] |= uint64_t(1) << (i % 64);
+						++done;
+					}
+					else
+						std::memset(out + r.offset, 0, r.size);
+					continue;
+				}
+
+				bool ok = Helpers::IsValidAddr(r.address) && r.address + r.size > r.address;
+				const uintptr_t last = (r.address + r.size - 1) >> 12;
+				for (uintptr_t page = r.address >> 12; ok && page <= last; ++page)
+				{
+					if (page != lastPage)
+					{
+						lastPage = page;
+						lastReadable = Memory::PageCache::Readable(page << 12, 1);
+					}
+					ok = lastReadable;
+				}
+
+				if (ok && !Memory::GuardedCopy(out + r.offset, reinterpret_cast<const void*>(r.address), r.size))
+				{
+					// page went away after it was cached: forget it so later requests re-query
+					Memory::PageCache::Forget(r.address, r.size);
+					lastPage = UINTPTR_MAX;
+					ok = false;
+				}
+
+				if (ok)
+				{
+					succeeded[i / 64] |= uint64_t(1) << (i % 64);
+					++done;
+				}
+				else
+					std::memset(out + r.offset, 0, r.size);
+			}
+			return done;
+		}
+
+		inline size_t ReadMany(const std::vector<ReadRequest>& requests, void* buffer, size_t bufferSize, std::vector<uint64_t>& succeeded)
+		{
+			return ReadMany(requests.data(), requests.size(), buffer, bufferSize, succeeded);
+		}
+
+		/* ReadMany for another process. Requests are sorted by address and neighbours less than gap
+		   bytes apart are fetched with one ReadProcessMemory, then scattered, so the syscall count
+		   follows the number of distinct spans rather than fields. A span that fails as a whole is
+		   retried entry by entry, so one bad field does not fail its neighbours. */
+		inline size_t ReadManyEx(HANDLE process, const ReadRequest* requests, size_t count, void* buffer, size_t bufferSize,
+			std::vector<uint64_t>& succeeded, size_t gap = 256)
+		{
+			constexpr size_t MaxSpan = size_t(64) << 10;
+			succeeded.assign((count + 63) / 64, 0);
+			uint8_t* out = static_cast<uint8_t*>(buffer);
+			if (!out || !count)
+				return 0;
+
+			std::vector<size_t> order;
+			order.reserve(count);
+			for (size_t i = 0; i < count; ++i)
+			{
+				const ReadRequest& r = requests[i];
+				if (r.size && r.offset <= bufferSize && r.size <= bufferSize - r.offset && r.address + r.size > r.address)
+					order.push_back(i);
+				else if (r.offset <= bufferSize && r.size <= bufferSize - r.offset)
+					std::memset(out + r.offset, 0, r.size);
+			}
+			std::sort(order.begin(), order.end(), [&](size_t a, size_t b) { return requests[a].address < requests[b].address; });
+
+			std::vector<uint8_t> scratch;
+			size_t done = 0;
+			auto finish = [&](size_t i, bool ok) {
+				if (ok) { succeeded[i / 64] |= uint64_t(1) << (i % 64); ++done; }
+				else std::memset(out + requests[i].offset, 0, requests[i].size);
+			};
+
+			for (size_t first = 0; first < order.size(); )
+			{
+				const uintptr_t start = requests[order[first]].address;
+				uintptr_t end = start + requests[order[first]].size;
+				size_t last = first + 1;
+				while (last < order.size())
+				{
+					const ReadRequest& r = requests[order[last]];
+					const uintptr_t rEnd = (std::max)(end, r.address + r.size);
+					if (r.address > end + gap || rEnd - start > MaxSpan)
+						break;
+					end = rEnd;
+					++last;
+				}
+
+				scratch.resize(end - start);
+				SIZE_T got = 0;
+				if (ReadProcessMemory(process, reinterpret_cast<LPCVOID>(start), scratch.data(), scratch.size(), &got) && got == scratch.size())
+				{
+					for (size_t k = first; k < last; ++k)
+					{
+						const ReadRequest& r = requests[order[k]];
+						std::memcpy(out + r.offset, scratch.data() + (r.address - start), r.size);
+						finish(order[k], true);
+					}
+				}
+				else
+				{
+					for (size_t k = first; k < last; ++k)
+					{
+						const ReadRequest& r = requests[order[k]];
+						got = 0;
+						const bool ok = ReadProcessMemory(process, reinterpret_cast<LPCVOID>(r.address), out + r.offset, r.size, &got) && got == r.size;
+						finish(order[k], ok);
+					}
+				}
+				first = last;
+			}
+			return done;
+		}
+
+		inline size_t ReadManyEx(HANDLE process, const std::vector<ReadRequest>& requests, void* buffer, size_t bufferSize,
+			std::vector<uint64_t>& succeeded, size_t gap = 256)
+		{
+			return ReadManyEx(process, requests.data(), requests.size(), buffer, bufferSize, succeeded, gap);
+		}
+
+		/* One member of a Mirror: a T at Offset from the object base */
+		template <typename T, size_t Offset>
+		struct Field
+		{
+			static_assert(std::is_trivially_copyable_v<T>, "mirrored fields must be trivially copyable");
+			using Type = T;
+			static constexpr size_t offset = Offset;
+		};
+
+		/* Local copy of the fields of one object, refreshed with a single read.
+		   The covering span [lowest offset, highest offset + size) is worked out at compile time;
+		   Refresh() copies it in one Memory::ReadBytes (no protection changes, backend-aware) and Get
+		   reads typed fields out of that copy, so every field comes from the same moment.
+		   Pointer fields are only followed when asked, through Follow.
+		   example: using Health = Utils::Field<int, 0x100>;
+		            using Weapon = Utils::Field<uintptr_t, 0x58>;
+		            using Player = Utils::Mirror<Health, Utils::Field<Vector::Vector3, 0x30>, Weapon>;
+		            Player p(entity);
+		            int hp = p.Get<Health>(); auto pos = p.Get<1>();
+		            int ammo = p.Follow<WeaponMirror, Weapon>().Get<Ammo>(); */
+		template <typename... Fields>
+		class Mirror
+		{
+			static_assert(sizeof...(Fields) > 0, "a Mirror needs at least one field");
+
+		public:
+			static constexpr size_t Begin = (std::min)({ Fields::offset... });
+			static constexpr size_t End = (std::max)({ (Fields::offset + sizeof(typename Fields::Type))... });
+			static constexpr size_t Span = End - Begin;
+
+			Mirror() = default;
+			explicit Mirror(uintptr_t base) { Refresh(base); }
+
+			/* Re-reads the whole span from base; on failure the mirror is invalid and Get returns zeroes */
+			bool Refresh(uintptr_t base) noexcept
+			{
+				m_base = base;
+				m_valid = Helpers::IsValidAddr(base) && Memory::ReadBytes(base + Begin, m_data.data(), Span);
+				if (!m_valid)
+					m_data.fill(0);
+				return m_valid;
+			}
+
+			bool Refresh() noexcept { return Refresh(m_base); }
+
+			bool Valid() const noexcept { return m_valid; }
+			uintptr_t Base() const noexcept { return m_base; }
+
+			/* Field by type */
+			template <typename F>
+			typename F::Type Get() const noexcept
+			{
+				static_assert((std::is_same_v<F, Fields> || ...), "field is not part of this Mirror");
+				typename F::Type value;
+				std::memcpy(&value, m_data.data() + (F::offset - Begin), sizeof(value));
+				return value;
+			}
+
+			/* Field by position in the Mirror's field list */
+			template <size_t I>
+			auto Get() const noexcept
+			{
+				return Get<std::tuple_element_t<I, std::tuple<Fields...>>>();
+			}
+
+			/* Writes one field to the object (Utils::Write) and to the local copy */
+			template <typename F>
+			bool Set(const typename F::Type& value) noexcept
+			{
+				static_assert((std::is_same_v<F, Fields> || ...), "field is not part of this Mirror");
+				if (!Write<typename F::Type>(m_base + F::offset, value))
+					return false;
+				std::memcpy(m_data.data() + (F::offset - Begin), &value, sizeof(value));
+				return true;
+			}
+
+			/* Mirror of the object a pointer field points at, read now */
+			template <typename Nested, typename F>
+			Nested Follow() const noexcept
+			{
+				static_assert(sizeof(typename F::Type) == sizeof(uintptr_t), "Follow needs a pointer-sized field");
+				uintptr_t target = 0;
+				std::memcpy(&target, m_data.data() + (F::offset - Begin), sizeof(target));
+				return Nested(target);
+			}
+
+		private:
+			uintptr_t m_base = 0;
+			bool m_valid = false;
+			std::array<uint8_t, Span> m_data{};
+		};
+
+		/* Walks base + offsets the classic way: dereference, add the offset, repeat.
+		   Every hop goes through Memory::ReadBytes (PageCache-checked, or the current backend)
+		   instead of IsBadReadPtr. */
+		inline uintptr_t FindDMAAddy(uintptr_t ptr, const std::vector<unsigned int>& offsets) noexcept
+		{
+			if (!ptr || offsets.empty())
+				return 0;
+
+			uintptr_t addr = ptr;
+
+			for (size_t i = 0; i < offsets.size(); ++i)
+			{
+				if (!Helpers::IsValidAddr(addr) || !Memory::ReadBytes(addr, &addr, sizeof(addr)))
+					return 0;
+
+				if (addr == 0 && i != offsets.size() - 1)
+					return 0;
+
+				addr += offsets[i];
+			}
+
+			return addr;
+		}
+
+		/* A FindDMAAddy chain built once and resolved many times.
+		   The walk caches every intermediate link; Resolve() then re-reads only the leaf pointer and
+		   walks the whole chain again when revalidateMs has passed, after Invalidate(), or when the
+		   leaf looks wrong (unreadable or null). Unlike FindDMAAddy a null leaf resolves to 0. */
+		class PointerChain
+		{
+		public:
+			PointerChain() = default;
+			PointerChain(uintptr_t base, std::vector<unsigned int> offsets, uint64_t revalidateMs = 1000)
+				: m_base(base), m_offsets(std::move(offsets)), m_links(m_offsets.size()), m_revalidateMs(revalidateMs) {}
+
+			/* Final address, or 0 when a link is unreadable or null */
+			uintptr_t Resolve() noexcept
+			{
+				return Resolve(GetTickCount64(), [](uintptr_t address) noexcept { return Deref(address); });
+			}
+
+			/* Resolves many chains at once. During full walks each pointer is read once per batch, so
+			   chains sharing a prefix (same base, same leading offsets) share those reads.
+			   out receives one address per chain; returns how many resolved. */
+			static size_t ResolveMany(std::vector<PointerChain>& chains, std::vector<uintptr_t>& out)
+			{
+				out.resize(chains.size());
+				std::unordered_map<uintptr_t, uintptr_t> seen;
+				auto deref = [&seen](uintptr_t address) {
+					auto it = seen.find(address);
+					if (it == seen.end())
+						it = seen.emplace(address, Deref(address)).first;
+					return it->second;
+				};
+
+				const uint64_t now = GetTickCount64();
+				size_t done = 0;
+				for (size_t i = 0; i < chains.size(); ++i)
+					done += (out[i] = chains[i].Resolve(now, deref)) != 0;
+				return done;
+			}
+
+			void Invalidate() noexcept { m_walked = false; }
+			bool Cached() const noexcept { return m_walked; }
+			uintptr_t Base() const noexcept { return m_base; }
+			const std::vector<unsigned int>& Offsets() const noexcept { return m_offsets; }
+			/* Address dereferenced at each hop as of the last walk; Links().back() holds the leaf pointer */
+			const std::vector<uintptr_t>& Links() const noexcept { return m_links; }
+
+		private:
+			/* Pointer stored at address, 0 if it cannot be read */
+			static uintptr_t Deref(uintptr_t address) noexcept
+			{
+				uintptr_t value = 0;
+				if (!Helpers::IsValidAddr(address) || !Memory::ReadBytes(address, &value, sizeof(value)))
+					return 0;
+				return value;
+			}
+
+			template <typename DerefFn>
+			uintptr_t Resolve(uint64_t now, DerefFn&& deref)
+			{
+				if (m_walked && now - m_walkedAt < m_revalidateMs)
+				{
+					if (const uintptr_t leaf = Deref(m_links.back()))
+						return leaf + m_offsets.back();
+				}
+				return Walk(now, deref);
+			}
+
+			template <typename DerefFn>
+			uintptr_t Walk(uint64_t now, DerefFn&& deref)
+			{
+				m_walked = false;
+				if (!m_base || m_offsets.empty())
+					return 0;
+
+				uintptr_t addr = m_base;
+				for (size_t i = 0; i < m_offsets.size(); ++i)
+				{
+					m_links[i] = addr;
+					const uintptr_t value = deref(addr);
+					if (!value)
+						return 0;
+					addr = value + m_offsets[i];
+				}
+
+				m_walked = true;
+				m_walkedAt = now;
+				return addr;
+			}
+
+			uintptr_t m_base = 0;
+			std::vector<unsigned int> m_offsets;
+			std::vector<uintptr_t> m_links;
+			uint64_t m_revalidateMs = 1000;
+			uint64_t m_walkedAt = 0;
+			bool m_walked = false;
+		};
+	}
+
+	namespace Opcode
+	{
+		/* Writes new opcodes*/
+		inline bool WriteOpcode(uintptr_t address, const std::vector<BYTE>& newBytes) noexcept
+		{
+			if (address == 0 || newBytes.empty())
+				return false;
+
+			BYTE* dest = reinterpret_cast<BYTE*>(address);
+
+			DWORD oldProtect = 0;
+			size_t size = newBytes.size();
+
+			// Change memory protection if requested
+			VirtualProtect(dest, size, PAGE_EXECUTE_READWRITE, &oldProtect);
+
+			// Copy the new bytes
+			std::memcpy(dest, newBytes.data(), size);
+
+			// Restore protection
+			VirtualProtect(dest, size, oldProtect, &oldProtect);
+			FlushInstructionCache(GetCurrentProcess(), dest, size);
+
+			return true;
+		}
+
+		inline std::vector<BYTE> ReadOpcode(uintptr_t address, size_t size)
+		{
+			if (address == 0 || size == 0)
+				return {};
+
+			const BYTE* src = reinterpret_cast<const BYTE*>(address);
+
+			std::vector<BYTE> buffer(size);
+			std::memcpy(buffer.data(), src, size);
+
+			return buffer;
+		}
+
+		/* A group of code patches applied and reverted as one unit.
+		   Add() records each site with its original bytes (ReadOpcode). Apply/Revert change the
+		   protection once per run of touched pages, write every entry, restore the protections and
+		   flush the instruction cache once for the whole batch. If any page cannot be made writable
+		   nothing is written. Entries may not overlap; the set is not reverted on destruction. */
+		class PatchSet
+		{
+		public:
+			/* Fails for unreadable or overlapping sites, and while the set is applied */
+			bool Add(uintptr_t address, const std::vector<BYTE>& bytes)
+			{
+				if (m_applied || !Helpers::IsValidAddr(address) || bytes.empty() || !Memory::PageCache::Readable(address, bytes.size()))
+					return false;
+
+				auto it = std::lower_bound(m_entries.begin(), m_entries.end(), address,
+					[](const Entry& e, uintptr_t a) { return e.address < a; });
+				if (it != m_entries.end() && it->address < address + bytes.size())
+					return false;
+				if (it != m_entries.begin() && (it - 1)->address + (it - 1)->patch.size() > address)
+					return false;
+
+				m_entries.insert(it, Entry{ address, bytes, ReadOpcode(address, bytes.size()) });
+				return true;
+			}
+
+			bool Apply()
+			{
+				if (!m_applied && !Write(true))
+					return false;
+				m_applied = true;
+				return true;
+			}
+
+			bool Revert()
+			{
+				if (m_applied && !Write(false))
+					return false;
+				m_applied = false;
+				return true;
+			}
+
+			bool Toggle() { return m_applied ? Revert() : Apply(); }
+
+			bool Applied() const noexcept { return m_applied; }
+			size_t Size() const noexcept { return m_entries.size(); }
+
+			/* Forgets every entry; refused while applied */
+			bool Clear()
+			{
+				if (m_applied)
+					return false;
+				m_entries.clear();
+				return true;
+			}
+
+		private:
+			struct Entry
+			{
+				uintptr_t address;
+				std::vector<BYTE> patch;
+				std::vector<BYTE> original;
+			};
+
+			struct Span
+			{
+				uintptr_t base;
+				size_t size;
+				DWORD protect;
+			};
+
+			bool Write(bool patched)
+			{
+				if (m_entries.empty())
+					return true;
+
+				constexpr uintptr_t pageMask = 0xFFF;
+				std::vector<Span> spans;
+				for (const Entry& e : m_entries)
+				{
+					const uintptr_t first = e.address & ~pageMask;
+					const uintptr_t end = (e.address + e.patch.size() + pageMask) & ~pageMask;
+					if (!spans.empty() && first <= spans.back().base + spans.back().size)
+						spans.back().size = (std::max)(spans.back().size, static_cast<size_t>(end - spans.back().base));
+					else
+						spans.push_back({ first, end - first, 0 });
+				}
+
+				// Split by region so every run is restored to its own protection; already writable runs are left alone.
+				std::vector<Span> changed;
+				bool ok = true;
+				for (const Span& s : spans)
+				{
+					MEMORY_BASIC_INFORMATION mbi{};
+					for (uintptr_t addr = s.base; ok && addr < s.base + s.size; )
+					{
+						if (!VirtualQuery(reinterpret_cast<LPCVOID>(addr), &mbi, sizeof(mbi)) || mbi.State != MEM_COMMIT)
+						{
+							ok = false;
+							break;
+						}
+						const uintptr_t end = (std::min)(reinterpret_cast<uintptr_t>(mbi.BaseAddress) + mbi.RegionSize, s.base + s.size);
+						if (!Memory::IsWritableProtect(mbi.Protect))
+						{
+							DWORD old = 0;
+							if (!VirtualProtect(reinterpret_cast<LPVOID>(addr), end - addr, PAGE_EXECUTE_READWRITE, &old))
+								ok = false;
+							else
+								changed.push_back({ addr, end - addr, old });
+						}
+						addr = end;
+					}
+				}
+
+				if (ok)
+				{
+					for (const Entry& e : m_entries)
+					{
+						const std::vector<BYTE>& bytes = patched ? e.patch : e.original;
+						std::memcpy(reinterpret_cast<void*>(e.address), bytes.data(), bytes.size());
+					}
+				}
+
+				for (const Span& s : changed)
+				{
+					DWORD old = 0;
+					VirtualProtect(reinterpret_cast<LPVOID>(s.base), s.size, s.protect, &old);
+				}
+				if (!changed.empty())
+					Memory::InvalidatePageCache();
+
+				if (ok)
+				{
+					const uintptr_t lo = m_entries.front().address;
+					const uintptr_t hi = m_entries.back().address + m_entries.back().patch.size();
+					FlushInstructionCache(GetCurrentProcess(), reinterpret_cast<LPCVOID>(lo), hi - lo);
+				}
+				return ok;
+			}
+
+			std::vector<Entry> m_entries;	// sorted by address
+			bool m_applied = false;
+		};
+	}
+
+	namespace Watch
+	{
+		/* One reading of a watched value */
+		struct Sample
+		{
+			uint64_t timeNs = 0;		// steady_clock time of the batch that read it
+			bool valid = false;			// false when the address (or a chain link) was unreadable
+			uint8_t bytes[16] = {};
+
+			template <typename T>
+			T As() const noexcept
+			{
+				static_assert(sizeof(T) <= sizeof(bytes) && std::is_trivially_copyable_v<T>, "watched types are trivially copyable, at most 16 bytes");
+				T value;
+				std::memcpy(&value, bytes, sizeof(T));
+				return value;
+			}
+		};
+
+		/* Consumer end of one watch. Pop/Drain take no locks; use them from one thread at a time.
+		   The ring has a fixed size: when the consumer falls behind, new samples are dropped and counted. */
+		class Channel
+		{
+		public:
+			bool Pop(Sample& out) noexcept { return m_ring.Pop(out); }
+
+			/* fn(const Sample&) for everything queued so far; returns how many */
+			template <typename F>
+			size_t Drain(F&& fn)
+			{
+				Sample s;
+				size_t n = 0;
+				for (; m_ring.Pop(s); ++n)
+					fn(static_cast<const Sample&>(s));
+				return n;
+			}
+
+			size_t Pending() const noexcept { return m_ring.Size(); }
+			uint64_t Dropped() const noexcept { return m_dropped.load(std::memory_order_relaxed); }
+
+		private:
+			friend class Sampler;
+
+			Channel(size_t capacity, uint32_t size, uint32_t periodMs, bool changesOnly)
+				: m_ring(capacity), m_size(size), m_periodNs(uint64_t(periodMs ? periodMs : 1) * 1000000), m_changesOnly(changesOnly) {}
+
+			Helpers::SpscRing<Sample> m_ring;
+			std::atomic<uint64_t> m_dropped{ 0 };
+
+			// owned by the sampler thread
+			uintptr_t m_address = 0;
+			Utils::PointerChain m_chain;
+			bool m_useChain = false;
+			uint32_t m_size;
+			uint64_t m_periodNs;
+			bool m_changesOnly;
+			uint64_t m_nextDue = 0;
+			bool m_published = false;
+			Sample m_last;
+		};
+
+		using Handle = std::shared_ptr<Channel>;
+
+		/* Polls registered addresses or pointer chains from one background thread.
+		   Every wake-up reads all due watches as one Utils::ReadMany batch (chains are resolved
+		   together through Utils::PointerChain::ResolveMany first) and pushes timestamped samples
+		   into each watch's ring; the batch runs outside the lock, so Add/Remove never wait on it;
+		   with changesOnly a sample is only published when the value or its validity changed.
+		   example: Watch::Sampler s; auto hp = s.Add<int>(addr, 50, true); s.Start();
+		            hp->Drain([](const Watch::Sample& x) { Log(x.As<int>()); }); */
+		class Sampler
+		{
+		public:
+			explicit Sampler(size_t ringCapacity = 1024) : m_capacity(ringCapacity) {}
+			~Sampler() { Stop(); }
+
+			Sampler(const Sampler&) = delete;
+			Sampler& operator=(const Sampler&) = delete;
+
+			template <typename T>
+			Handle Add(uintptr_t address, uint32_t periodMs, bool changesOnly = false)
+			{
+				static_assert(sizeof(T) <= sizeof(Sample::bytes) && std::is_trivially_copyable_v<T>, "watched types are trivially copyable, at most 16 bytes");
+				Handle h(new Channel(m_capacity, sizeof(T), periodMs, changesOnly));
+				h->m_address = address;
+				return Register(std::move(h));
+			}
+
+			template <typename T>
+			Handle Add(Utils::PointerChain chain, uint32_t periodMs, bool changesOnly = false)
+			{
+				static_assert(sizeof(T) <= sizeof(Sample::bytes) && std::is_trivially_copyable_v<T>, "watched types are trivially copyable, at most 16 bytes");
+				Handle h(new Channel(m_capacity, sizeof(T), periodMs, changesOnly));
+				h->m_chain = std::move(chain);
+				h->m_useChain = true;
+				return Register(std::move(h));
+			}
+
+			/* Stops sampling the watch; samples already queued stay readable through the handle.
+			   A batch already in flight may still push one more sample. */
+			void Remove(const Handle& h)
+			{
+				std::lock_guard<std::mutex> lg(m_mx);
+				m_watches.erase(std::remove(m_watches.begin(), m_watches.end(), h), m_watches.end());
+			}
+
+			void Start()
+			{
+				std::lock_guard<std::mutex> lg(m_mx);
+				if (m_thread.joinable())
+					return;
+				m_stopping = false;
+				m_thread = std::thread([this] { Run(); });
+			}
+
+			void Stop()
+			{
+				{
+					std::lock_guard<std::mutex> lg(m_mx);
+					m_stopping = true;
+				}
+				m_cv.notify_all();
+				if (m_thread.joinable())
+					m_thread.join();
+			}
+
+			bool Running() const noexcept { return m_thread.joinable(); }
+
+		private:
+			static uint64_t NowNs() noexcept
+			{
+				return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+					std::chrono::steady_clock::now().time_since_epoch()).count());
+			}
+
+			Handle Register(Handle h)
+			{
+				{
+					std::lock_guard<std::mutex> lg(m_mx);
+					m_watches.push_back(h);
+				}
+				m_cv.notify_all();	// due at once, may be sooner than the current wait
+				return h;
+			}
+
+			void Run()
+			{
+				std::vector<Handle> due;
+				std::vector<Utils::PointerChain> chains;
+				std::vector<uintptr_t> resolved;
+				std::vector<Utils::ReadRequest> requests;
+				std::vector<uint64_t> succeeded;
+				std::vector<uint8_t> buffer;
+
+				std::unique_lock<std::mutex> lk(m_mx);
+				while (!m_stopping)
+				{
+					/* Only the list of due watches is taken under the lock; the handles keep a
+					   watch removed meanwhile alive until the batch is done with it. */
+					const uint64_t now = NowNs();
+					due.clear();
+					for (const Handle& w : m_watches)
+						if (w->m_nextDue <= now)
+							due.push_back(w);
+					lk.unlock();
+
+					/* Chains are lent to one ResolveMany call so shared prefixes are read once */
+					chains.clear();
+					for (const Handle& w : due)
+						if (w->m_useChain)
+							chains.push_back(std::move(w->m_chain));
+					Utils::PointerChain::ResolveMany(chains, resolved);
+
+					requests.clear();
+					for (size_t i = 0, c = 0; i < due.size(); ++i)
+					{
+						Channel& w = *due[i];
+						uintptr_t address = w.m_address;
+						if (w.m_useChain)
+						{
+							address = resolved[c];
+							w.m_chain = std::move(chains[c++]);
+						}
+						requests.push_back({ address, w.m_size, i * sizeof(Sample::bytes) });
+					}
+
+					buffer.resize(due.size() * sizeof(Sample::bytes));
+					Utils::ReadMany(requests, buffer.data(), buffer.size(), succeeded);
+
+					for (size_t i = 0; i < due.size(); ++i)
+					{
+						Channel& w = *due[i];
+						Sample s;
+						s.timeNs = now;
+						s.valid = Utils::ReadSucceeded(succeeded, i);
+						std::memcpy(s.bytes, buffer.data() + i * sizeof(Sample::bytes), w.m_size);
+
+						const bool same = w.m_published && s.valid == w.m_last.valid && std::memcmp(s.bytes, w.m_last.bytes, w.m_size) == 0;
+						if (!w.m_changesOnly || !same)
+						{
+							if (w.m_ring.Push(s))
+							{
+								w.m_last = s;
+								w.m_published = true;
+							}
+							else
+								w.m_dropped.fetch_add(1, std::memory_order_relaxed);
+						}
+
+						// keep the cadence, but don't try to catch up after a stall
+						w.m_nextDue += w.m_periodNs;
+						if (w.m_nextDue <= now)
+							w.m_nextDue = now + w.m_periodNs;
+					}
+					due.clear();
+
+					lk.lock();
+					if (m_stopping)
+						break;
+					uint64_t next = now + 100000000;	// idle re-check every 100 ms
+					for (const Handle& w : m_watches)
+						next = (std::min)(next, w->m_nextDue);
+					if (next > now)
+						m_cv.wait_for(lk, std::chrono::nanoseconds(next - now));
+				}
+			}
+
+			size_t m_capacity;
+			std::vector<Handle> m_watches;
+			std::mutex m_mx;
+			std::condition_variable m_cv;
+			std::thread m_thread;
+			bool m_stopping = false;
+		};
+	}
+
+    namespace String
+    {
+        // Byte offset of the first NUL unit (1 or 2 bytes wide) in p[0, bytes), bytes if none.
+        // Loads are aligned blocks, so they never touch a page that p[0, bytes) does not; p must be
+        // aligned to the unit size.
+        IMH_TARGET("sse2")
+        inline size_t FindTerminatorSse2(const uint8_t* p, size_t bytes, bool wide) noexcept
+        {
+            const uintptr_t start = reinterpret_cast<uintptr_t>(p);
+            const uint8_t* block = reinterpret_cast<const uint8_t*>(start & ~uintptr_t(15));
+            const __m128i zero = _mm_setzero_si128();
+            for (unsigned skip = static_cast<unsigned>(start & 15); ; skip = 0) {
+                const __m128i v = _mm_load_si128(reinterpret_cast<const __m128i*>(block));
+                const uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(wide ? _mm_cmpeq_epi16(v, zero) : _mm_cmpeq_epi8(v, zero))) & (0xFFFFu << skip);
+                if (mask)
+                    return (std::min)(static_cast<size_t>(reinterpret_cast<uintptr_t>(block) + Helpers::CountTrailingZeros(mask) - start), bytes);
+                block += 16;
+                if (block >= p + bytes)
+                    return bytes;
+            }
+        }
+
+        IMH_TARGET("avx2")
+        inline size_t FindTerminatorAvx2(const uint8_t* p, size_t bytes, bool wide) noexcept
+        {
+            const uintptr_t start = reinterpret_cast<uintptr_t>(p);
+            const uint8_t* block = reinterpret_cast<const uint8_t*>(start & ~uintptr_t(31));
+            const __m256i zero = _mm256_setzero_si256();
+            for (unsigned skip = static_cast<unsigned>(start & 31); ; skip = 0) {
+                const __m256i v = _mm256_load_si256(reinterpret_cast<const __m256i*>(block));
+                const uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(wide ? _mm256_cmpeq_epi16(v, zero) : _mm256_cmpeq_epi8(v, zero))) & (0xFFFFFFFFu << skip);
+                if (mask)
+                    return (std::min)(static_cast<size_t>(reinterpret_cast<uintptr_t>(block) + Helpers::CountTrailingZeros(mask) - start), bytes);
+                block += 32;
+                if (block >= p + bytes)
+                    return bytes;
+            }
+        }
+
+        // Index of the first NUL in p[0, n), n if none. Only reads the pages p[0, n) lies on.
+        template <typename Char>
+        size_t FindTerminator(const Char* p, size_t n) noexcept
+        {
+            if (!n)
+                return 0;
+            if constexpr (sizeof(Char) <= 2) {
+                const Helpers::CpuFeatures& cpu = Helpers::GetCpuFeatures();
+                if (reinterpret_cast<uintptr_t>(p) % sizeof(Char) == 0 && (cpu.avx2 || cpu.sse2)) {
+                    const uint8_t* b = reinterpret_cast<const uint8_t*>(p);
+                    const size_t at = cpu.avx2 ? FindTerminatorAvx2(b, n * sizeof(Char), sizeof(Char) == 2)
+                                               : FindTerminatorSse2(b, n * sizeof(Char), sizeof(Char) == 2);
+                    return at / sizeof(Char);
+                }
+            }
+            for (size_t i = 0; i < n; ++i)
+                if (p[i] == Char(0)) return i;
+            return n;
+        }
+
+        // Copies a NUL-terminated string of at most maxCount characters into out and returns its
+        // length. Local memory is checked against Memory::PageCache and copied in chunks of up to
+        // 256 bytes (never across a page) with Memory::GuardedCopy, so a page freed since it was
+        // cached ends the string instead of faulting; the terminator is then searched in the copy
+        // with FindTerminator. With a backend set, whole pages are read through it. Copying stops
+        // at the terminator or at the first unreadable page.
+        template <typename Char>
+        size_t CopyTerminated(uintptr_t address, Char* out, size_t maxCount) noexcept
+        {
+            constexpr uintptr_t page = 4096;
+            constexpr size_t localStep = (std::max<size_t>)(256 / sizeof(Char), 1);  // short names never copy whole pages
+            Memory::Backend* backend = Memory::CurrentBackend();
+            size_t count = 0;
+            while (count < maxCount) {
+                const size_t room = (page - (address & (page - 1))) / sizeof(Char);
+                size_t n = (std::min)((std::max<size_t>)(room, 1), maxCount - count);  // room 0: a unit straddles two pages
+                size_t found;
+                if (backend) {
+                    if (!backend->Read(address, out + count, n * sizeof(Char)))
+                        break;
+                    const Char* nul = std::char_traits<Char>::find(out + count, n, Char(0));
+                    found = nul ? static_cast<size_t>(nul - (out + count)) : n;
+                }
+                else {
+                    n = (std::min)(n, localStep);
+                    if (!Memory::PageCache::Readable(address, n * sizeof(Char)))
+                        break;
+                    if (!Memory::GuardedCopy(out + count, reinterpret_cast<const void*>(address), n * sizeof(Char))) {
+                        Memory::PageCache::Forget(address, n * sizeof(Char));
+                        break;
+                    }
+                    found = FindTerminator(out + count, n);
+                }
+                count += found;
+                if (found < n)
+                    break;
+                address += n * sizeof(Char);
+            }
+            return count;
+        }
+
+        // Core string reading functions
+        template <size_t N>
+        bool WriteBuffer(uintptr_t address, const char* newStr, bool protect = true) noexcept
+        {
+            if (!Helpers::IsValidAddr(address) || !newStr)
+                return false;
+
+            if (Memory::Backend* backend = Memory::CurrentBackend()) {
+                char buffer[N] = {};
+                strncpy_s(buffer, N, newStr, N - 1);
+                return backend->Write(address, buffer, N);
+            }
+
+            char* dest = reinterpret_cast<char*>(address);
+            DWORD oldProtect = 0;
+
+            if (protect && !VirtualProtect(dest, N, PAGE_EXECUTE_READWRITE, &oldProtect))
+                return false;
+
+            try {
+                memset(dest, 0, N);
+                strncpy_s(dest, N, newStr, N - 1);
+                dest[N - 1] = '\0';
+            }
+            catch (...) {
+                if (protect) VirtualProtect(dest, N, oldProtect, &oldProtect);
+                return false;
+            }
+
+            if (protect) VirtualProtect(dest, N, oldProtect, &oldProtect);
+            return true;
+        }
+
+        template <size_t N>
+        std::string ReadBuffer(uintptr_t address) noexcept
+        {
+            if (!Helpers::IsValidAddr(address))
+                return {};
+
+            if (Memory::Backend* backend = Memory::CurrentBackend()) {
+                char buffer[N + 1] = {};
+                return backend->Read(address, buffer, N) ? std::string(buffer) : std::string{};
+            }
+
+            try {
+                const char* src = reinterpret_cast<const char*>(address);
+                char buffer[N + 1] = {};
+                memcpy(buffer, src, N);
+                buffer[N] = '\0';
+                return std::string(buffer);
+            }
+            catch (...) {
+                return {};
+            }
+        }
+
+        // Wide string functions
+        template <size_t N>
+        bool WriteWideBuffer(uintptr_t address, const wchar_t* newStr, bool protect = true) noexcept
+        {
+            if (!Helpers::IsValidAddr(address) || !newStr)
+                return false;
+
+            if (Memory::Backend* backend = Memory::CurrentBackend()) {
+                wchar_t buffer[N] = {};
+                wcsncpy_s(buffer, N, newStr, N - 1);
+                return backend->Write(address, buffer, N * sizeof(wchar_t));
+            }
+
+            wchar_t* dest = reinterpret_cast<wchar_t*>(address);
+            DWORD oldProtect = 0;
+            SIZE_T byteSize = N * sizeof(wchar_t);
+
+            if (protect && !VirtualProtect(dest, byteSize, PAGE_EXECUTE_READWRITE, &oldProtect))
+                return false;
+
+            try {
+                memset(dest, 0, byteSize);
+                wcsncpy_s(dest, N, newStr, N - 1);
+                dest[N - 1] = L'\0';
+            }
+            catch (...) {
+                if (protect) VirtualProtect(dest, byteSize, oldProtect, &oldProtect);
+                return false;
+            }
+
+            if (protect) VirtualProtect(dest, byteSize, oldProtect, &oldProtect);
+            return true;
+        }
+
+        template <size_t N>
+        std::wstring ReadWideBuffer(uintptr_t address) noexcept
+        {
+            if (!Helpers::IsValidAddr(address))
+                return {};
+
+            if (Memory::Backend* backend = Memory::CurrentBackend()) {
+                wchar_t buffer[N + 1] = {};
+                return backend->Read(address, buffer, N * sizeof(wchar_t)) ? std::wstring(buffer) : std::wstring{};
+            }
+
+            try {
+                const wchar_t* src = reinterpret_cast<const wchar_t*>(address);
+                wchar_t buffer[N + 1] = {};
+                wmemcpy(buffer, src, N);
+                buffer[N] = L'\0';
+                return std::wstring(buffer);
+            }
+            catch (...) {
+                return {};
+            }
+        }
+
+        // Dynamic string reading with safety: pages are validated once each and the terminator is
+        // found 16/32 bytes at a time (see CopyTerminated)
+        std::string ReadString(uintptr_t address, size_t maxLength = 256) noexcept
+        {
+            if (!Helpers::IsValidAddr(address))
+                return {};
+
+            try {
+                char small[256];
+                if (maxLength <= std::size(small))
+                    return std::string(small, CopyTerminated(address, small, maxLength));
+                std::string out(maxLength, '\0');
+                out.resize(CopyTerminated(address, out.data(), maxLength));
+                return out;
+            }
+            catch (...) {
+                return {};
+            }
+        }
+
+        std::wstring ReadWideString(uintptr_t address, size_t maxLength = 256) noexcept
+        {
+            if (!Helpers::IsValidAddr(address))
+                return {};
+
+            try {
+                wchar_t small[256];
+                if (maxLength <= std::size(small))
+                    return std::wstring(small, CopyTerminated(address, small, maxLength));
+                std::wstring out(maxLength, L'\0');
+                out.resize(CopyTerminated(address, out.data(), maxLength));
+                return out;
+            }
+            catch (...) {
+                return {};
+            }
+        }
+
+        // Allocation-free variants: the string is copied into the caller's scratch buffer (at most
+        // its size in characters) and the view points there, valid until the buffer is reused.
+        // example: char name[64]; std::string_view v = IMH::String::ReadStringView(addr, name);
+        inline std::string_view ReadStringView(uintptr_t address, char* scratch, size_t scratchSize) noexcept
+        {
+            if (!Helpers::IsValidAddr(address) || !scratch)
+                return {};
+            return std::string_view(scratch, CopyTerminated(address, scratch, scratchSize));
+        }
+
+        template <size_t N>
+        std::string_view ReadStringView(uintptr_t address, char (&scratch)[N]) noexcept
+        {
+            return ReadStringView(address, scratch, N);
+        }
+
+        inline std::wstring_view ReadWideStringView(uintptr_t address, wchar_t* scratch, size_t scratchSize) noexcept
+        {
+            if (!Helpers::IsValidAddr(address) || !scratch)
+                return {};
+            return std::wstring_view(scratch, CopyTerminated(address, scratch, scratchSize));
+        }
+
+        template <size_t N>
+        std::wstring_view ReadWideStringView(uintptr_t address, wchar_t (&scratch)[N]) noexcept
+        {
+            return ReadWideStringView(address, scratch, N);
+        }
+
+        // ---- UTF-16 -> UTF-8 ----
+        // Worst-case UTF-8 size for n source units: 3 bytes per UTF-16 unit (a surrogate pair is two
+        // units and four bytes), 4 per UTF-32 unit (wchar_t outside Windows).
+        template <typename Char>
+        constexpr size_t Utf8Capacity(size_t units) noexcept
+        {
+            return units * (sizeof(Char) == 2 ? 3 : 4);
+        }
+
+        // Narrows the leading ASCII blocks of src[0, n) into dst and returns how many units were
+        // copied (a multiple of the block size; the caller finishes the rest).
+        IMH_TARGET("sse2")
+        inline size_t NarrowAsciiSse2(const char16_t* src, size_t n, char* dst) noexcept
+        {
+            const __m128i high = _mm_set1_epi16(static_cast<short>(0xFF80));
+            const __m128i zero = _mm_setzero_si128();
+            size_t i = 0;
+            for (; i + 16 <= n; i += 16) {
+                const __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+                const __m128i b = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i + 8));
+                if (_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(_mm_or_si128(a, b), high), zero)) != 0xFFFF)
+                    break;
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi16(a, b));
+            }
+            return i;
+        }
+
+        IMH_TARGET("avx2")
+        inline size_t NarrowAsciiAvx2(const char16_t* src, size_t n, char* dst) noexcept
+        {
+            const __m256i high = _mm256_set1_epi16(static_cast<short>(0xFF80));
+            size_t i = 0;
+            for (; i + 32 <= n; i += 32) {
+                const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+                const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i + 16));
+                if (!_mm256_testz_si256(_mm256_or_si256(a, b), high))
+                    break;
+                // packus works per 128-bit lane: restore the order a.lo a.hi b.lo b.hi
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_permute4x64_epi64(_mm256_packus_epi16(a, b), 0xD8));
+            }
+            return i;
+        }
+
+        // Writes one code point (at most 4 bytes) and returns the byte count.
+        inline size_t EncodeUtf8(uint32_t cp, char* dst) noexcept
+        {
+            if (cp < 0x80) {
+                dst[0] = static_cast<char>(cp);
+                return 1;
+            }
+            if (cp < 0x800) {
+                dst[0] = static_cast<char>(0xC0 | (cp >> 6));
+                dst[1] = static_cast<char>(0x80 | (cp & 0x3F));
+                return 2;
+            }
+            if (cp < 0x10000) {
+                dst[0] = static_cast<char>(0xE0 | (cp >> 12));
+                dst[1] = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+                dst[2] = static_cast<char>(0x80 | (cp & 0x3F));
+                return 3;
+            }
+            dst[0] = static_cast<char>(0xF0 | (cp >> 18));
+            dst[1] = static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+            dst[2] = static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+            dst[3] = static_cast<char>(0x80 | (cp & 0x3F));
+            return 4;
+        }
+
+        // Converts src[0, n) to UTF-8 in one pass and returns the number of bytes written; dst must
+        // hold Utf8Capacity<char16_t>(n) bytes. ASCII runs go through SSE2/AVX2 blocks, pairs are
+        // combined, unpaired surrogates become U+FFFD. No terminator is written.
+        // example: char buf[IMH::String::Utf8Capacity<char16_t>(64)];
+        //          size_t len = IMH::String::Utf16ToUtf8(units, count, buf);
+        inline size_t Utf16ToUtf8(const char16_t* src, size_t n, char* dst) noexcept
+        {
+            const Helpers::CpuFeatures& cpu = Helpers::GetCpuFeatures();
+            size_t i = 0, o = 0;
+            while (i < n) {
+                const uint32_t c = src[i];
+                if (c < 0x80) {
+                    const size_t run = cpu.avx2 ? NarrowAsciiAvx2(src + i, n - i, dst + o)
+                                     : cpu.sse2 ? NarrowAsciiSse2(src + i, n - i, dst + o) : 0;
+                    i += run;
+                    o += run;
+                    while (i < n && src[i] < 0x80)
+                        dst[o++] = static_cast<char>(src[i++]);
+                    continue;
+                }
+                if (c - 0xD800 >= 0x800) {
+                    o += EncodeUtf8(c, dst + o);
+                    ++i;
+                }
+                else if (c < 0xDC00 && i + 1 < n && static_cast<uint32_t>(src[i + 1]) - 0xDC00 < 0x400) {
+                    o += EncodeUtf8(0x10000 + ((c - 0xD800) << 10) + (src[i + 1] - 0xDC00), dst + o);
+                    i += 2;
+                }
+                else {
+                    o += EncodeUtf8(0xFFFD, dst + o);
+                    ++i;
+                }
+            }
+            return o;
+        }
+
+        // wchar_t is UTF-16 on Windows; elsewhere it is UTF-32 and each unit is encoded directly.
+        // dst must hold Utf8Capacity<wchar_t>(n) bytes.
+        inline size_t WideToUtf8(const wchar_t* src, size_t n, char* dst) noexcept
+        {
+            if constexpr (sizeof(wchar_t) == sizeof(char16_t)) {
+                return Utf16ToUtf8(reinterpret_cast<const char16_t*>(src), n, dst);
+            }
+            else {
+                size_t o = 0;
+                for (size_t i = 0; i < n; ++i) {
+                    const uint32_t c = static_cast<uint32_t>(src[i]);
+                    o += EncodeUtf8((c > 0x10FFFF || c - 0xD800 < 0x800) ? 0xFFFD : c, dst + o);
+                }
+                return o;
+            }
+        }
+
+        inline std::string Utf16ToUtf8(std::u16string_view src)
+        {
+            std::string out(Utf8Capacity<char16_t>(src.size()), '\0');
+            out.resize(Utf16ToUtf8(src.data(), src.size(), out.data()));
+            return out;
+        }
+
+        // String conversion utility. Stops at the first L'\0', like the old c_str()-based conversion.
+        inline std::string WideToString(std::wstring_view wstr) noexcept
+        {
+            wstr = wstr.substr(0, wstr.find(L'\0'));
+            if (wstr.empty())
+                return {};
+
+            try {
+                std::string out(Utf8Capacity<wchar_t>(wstr.size()), '\0');
+                out.resize(WideToUtf8(wstr.data(), wstr.size(), out.data()));
+                return out;
+            }
+            catch (...) {
+                return {};
+            }
+        }
+
+        // Reads a wide string and returns it as UTF-8 with a single allocation (the result).
+        // example: std::string name = IMH::String::ReadWideStringUtf8(entity + 0x60);
+        inline std::string ReadWideStringUtf8(uintptr_t address, size_t maxLength = 256) noexcept
+        {
+            if (!Helpers::IsValidAddr(address))
+                return {};
+
+            try {
+                wchar_t small[256];
+                if (maxLength <= std::size(small)) {
+                    char utf8[Utf8Capacity<wchar_t>(std::size(small))];
+                    return std::string(utf8, WideToUtf8(small, CopyTerminated(address, small, maxLength), utf8));
+                }
+                std::vector<wchar_t> wide(maxLength);
+                return WideToString(std::wstring_view(wide.data(), CopyTerminated(address, wide.data(), maxLength)));
+            }
+            catch (...) {
+                return {};
+            }
+        }
+
+        // Validation result structure
+        struct StringInfo
+        {
+            std::string value;
+            bool isValid;
+            size_t length;
+        };
+
+        StringInfo ReadStringInfo(uintptr_t address, size_t maxLength = 256) noexcept
+        {
+            StringInfo info = { {}, false, 0 };
+
+            std::string str = ReadString(address, maxLength);
+            info.value = str;
+            info.length = str.length();
+            info.isValid = !str.empty();
+
+            return info;
+        }
+
+        // Interning cache for strings read again and again, e.g. entity names every frame.
+        // Entries are keyed by (address, max length, narrow/wide) and keep the text (UTF-8 for wide
+        // sources) in an arena. A lookup re-reads only the first bytes of the source (up to 32,
+        // terminator included, so short names are compared exactly) and returns the cached view when
+        // they still match: no allocation, no full read. NextFrame() advances the generation, evicts
+        // entries unused for maxAge generations and compacts the arena once it is mostly garbage.
+        // Views stay valid until the next NextFrame()/Clear(). Not thread-safe: one cache per thread.
+        // example: IMH::String::StringCache names;
+        //          std::string_view n = names.Get(entity + 0x40);   // every frame
+        //          names.NextFrame();                               // end of frame
+        class StringCache
+        {
+        public:
+            explicit StringCache(uint32_t maxAge = 120) : m_maxAge(maxAge) {}
+
+            StringCache(const StringCache&) = delete;
+            StringCache& operator=(const StringCache&) = delete;
+
+            std::string_view Get(uintptr_t address, size_t maxLength = 256) { return Lookup<char>(address, maxLength); }
+
+            // Wide source, returned as UTF-8
+            std::string_view GetWide(uintptr_t address, size_t maxLength = 256) { return Lookup<wchar_t>(address, maxLength); }
+
+            void NextFrame()
+            {
+                ++m_generation;
+                for (auto it = m_entries.begin(); it != m_entries.end(); ) {
+                    if (m_generation - it->second.lastUsed > m_maxAge) {
+                        m_garbage += it->second.length;
+                        it = m_entries.erase(it);
+                    }
+                    else
+                        ++it;
+                }
+                if (m_garbage > BlockSize && m_garbage * 2 > m_stored)
+                    Compact();
+            }
+
+            void Clear()
+            {
+                m_entries.clear();
+                m_blocks.clear();
+                m_blockUsed = m_blockSize = m_stored = m_garbage = 0;
+            }
+
+            size_t Size() const noexcept { return m_entries.size(); }
+            uint64_t Hits() const noexcept { return m_hits; }
+            uint64_t Misses() const noexcept { return m_misses; }
+            size_t ArenaBytes() const noexcept { return m_stored; }
+
+        private:
+            static constexpr size_t BlockSize = 64 * 1024;
+            static constexpr size_t ProbeBytes = 32;
+
+            struct Key
+            {
+                uintptr_t address;
+                size_t maxLength;
+                bool wide;
+                bool operator==(const Key& o) const noexcept { return address == o.address && maxLength == o.maxLength && wide == o.wide; }
+            };
+
+            struct KeyHash
+            {
+                size_t operator()(const Key& k) const noexcept
+                {
+                    uint64_t h = (static_cast<uint64_t>(k.address) ^ (static_cast<uint64_t>(k.maxLength) << 48) ^ (k.wide ? 1ull << 63 : 0)) * 0x9E3779B97F4A7C15ull;
+                    return static_cast<size_t>(h ^ (h >> 29));
+                }
+            };
+
+            struct Entry
+            {
+                const char* text = nullptr;
+                size_t length = 0;
+                uint32_t lastUsed = 0;
+                uint8_t probeLength = 0;
+                uint8_t probe[ProbeBytes] = {};
+            };
+
+            template <typename Char>
+            std::string_view Lookup(uintptr_t address, size_t maxLength)
+            {
+                if (!Helpers::IsValidAddr(address) || !maxLength)
+                    return {};
+
+                const Key key{ address, maxLength, sizeof(Char) > 1 };
+                auto it = m_entries.find(key);
+                uint8_t probe[ProbeBytes];
+                if (it != m_entries.end()) {
+                    Entry& e = it->second;
+                    if (Memory::ReadBytes(address, probe, e.probeLength) && std::memcmp(probe, e.probe, e.probeLength) == 0) {
+                        e.lastUsed = m_generation;
+                        ++m_hits;
+                        return { e.text, e.length };
+                    }
+                }
+                ++m_misses;
+
+                Char small[256];
+                std::vector<Char> large;
+                Char* raw = small;
+                if (maxLength > std::size(small)) {
+                    large.resize(maxLength);
+                    raw = large.data();
+                }
+                const size_t count = CopyTerminated(address, raw, maxLength);
+
+                Entry& e = it != m_entries.end() ? it->second : m_entries[key];
+                m_garbage += e.length;
+                e.lastUsed = m_generation;
+
+                // The probe is the leading raw bytes plus the terminator, when it was seen.
+                const size_t rawBytes = count * sizeof(Char) + (count < maxLength ? sizeof(Char) : 0);
+                e.probeLength = static_cast<uint8_t>((std::min)(rawBytes, ProbeBytes));
+                std::memset(e.probe, 0, sizeof(e.probe));
+                std::memcpy(e.probe, raw, (std::min)(count * sizeof(Char), size_t(e.probeLength)));
+
+                if constexpr (sizeof(Char) == 1) {
+                    e.text = Store(raw, count);
+                    e.length = count;
+                }
+                else {
+                    char* dst = Reserve(Utf8Capacity<Char>(count));
+                    e.length = WideToUtf8(raw, count, dst);
+                    e.text = Commit(dst, e.length);
+                }
+                return { e.text, e.length };
+            }
+
+            // Room for n bytes at the end of the arena; Commit() claims what was actually written
+            char* Reserve(size_t n)
+            {
+                if (m_blocks.empty() || m_blockUsed + n > m_blockSize) {
+                    m_blockSize = (std::max)(BlockSize, n);
+                    m_blocks.push_back(std::make_unique<char[]>(m_blockSize));
+                    m_blockUsed = 0;
+                }
+                return m_blocks.back().get() + m_blockUsed;
+            }
+
+            const char* Commit(const char* dst, size_t n) noexcept
+            {
+                m_blockUsed += n;
+                m_stored += n;
+                return dst;
+            }
+
+            const char* Store(const char* s, size_t n)
+            {
+                char* dst = Reserve(n);
+                if (n) std::memcpy(dst, s, n);
+                return Commit(dst, n);
+            }
+
+            // Copies the live strings into fresh blocks and frees the old ones
+            void Compact()
+            {
+                std::vector<std::unique_ptr<char[]>> old = std::move(m_blocks);
+                m_blocks.clear();
+                m_blockUsed = m_blockSize = m_stored = m_garbage = 0;
+                for (auto& kv : m_entries)
+                    kv.second.text = Store(kv.second.text, kv.second.length);
+            }
+
+            std::unordered_map<Key, Entry, KeyHash> m_entries;
+            std::vector<std::unique_ptr<char[]>> m_blocks;
+            size_t m_blockUsed = 0, m_blockSize = 0;
+            size_t m_stored = 0, m_garbage = 0;
+            uint32_t m_generation = 0;
+            uint32_t m_maxAge;
+            uint64_t m_hits = 0, m_misses = 0;
+        };
+    }
+
+    namespace ByteCodes
+    {
+        // Existing opcodes
+        constexpr BYTE NOP = 0x90;
+        constexpr BYTE RET = 0xC3;
+        constexpr BYTE CALL = 0xE8;
+        constexpr BYTE JMP = 0xE9;
+        constexpr BYTE JE = 0x74;
+        constexpr BYTE JNE = 0x75;
+        constexpr BYTE JG = 0x7F;
+        constexpr BYTE JL = 0x7C;
+        constexpr BYTE JGE = 0x7D;
+        constexpr BYTE JLE = 0x7E;
+        constexpr BYTE PUSH = 0x68;
+
+        // Additional common opcodes
+        constexpr BYTE POP = 0x58;          // POP register (base, add register number)
+        constexpr BYTE MOV_REG_IMM32 = 0xB8; // MOV register, immediate32 (base, add register number)
+        constexpr BYTE MOV_EAX_MEM = 0xA1;  // MOV EAX, memory
+        constexpr BYTE MOV_MEM_EAX = 0xA3;  // MOV memory, EAX
+        constexpr BYTE MOV_RM_R = 0x89;     // MOV r/m, register
+        constexpr BYTE MOV_R_RM = 0x8B;     // MOV register, r/m
+
+        // Short jumps (2-byte instructions)
+        constexpr BYTE JMP_SHORT = 0xEB;    // JMP short
+        constexpr BYTE JZ = 0x74;           // JZ (alias for JE)
+        constexpr BYTE JNZ = 0x75;          // JNZ (alias for JNE)
+        constexpr BYTE JS = 0x78;           // Jump if sign
+        constexpr BYTE JNS = 0x79;          // Jump if not sign
+        constexpr BYTE JO = 0x70;           // Jump if overflow
+        constexpr BYTE JNO = 0x71;          // Jump if not overflow
+        constexpr BYTE JB = 0x72;           // Jump if below (unsigned)
+        constexpr BYTE JAE = 0x73;          // Jump if above or equal (unsigned)
+        constexpr BYTE JBE = 0x76;          // Jump if below or equal (unsigned)
+        constexpr BYTE JA = 0x77;           // Jump if above (unsigned)
+
+        // Arithmetic operations
+        constexpr BYTE ADD_AL_IMM8 = 0x04;  // ADD AL, immediate8
+        constexpr BYTE ADD_EAX_IMM32 = 0x05; // ADD EAX, immediate32
+        constexpr BYTE SUB_AL_IMM8 = 0x2C;  // SUB AL, immediate8
+        constexpr BYTE SUB_EAX_IMM32 = 0x2D; // SUB EAX, immediate32
+        constexpr BYTE CMP_AL_IMM8 = 0x3C;  // CMP AL, immediate8
+        constexpr BYTE CMP_EAX_IMM32 = 0x3D; // CMP EAX, immediate32
+
+        // Stack operations
+        constexpr BYTE PUSH_EAX = 0x50;     // PUSH EAX
+        constexpr BYTE PUSH_ECX = 0x51;     // PUSH ECX
+        constexpr BYTE PUSH_EDX = 0x52;     // PUSH EDX
+        constexpr BYTE PUSH_EBX = 0x53;     // PUSH EBX
+        constexpr BYTE PUSH_ESP = 0x54;     // PUSH ESP
+        constexpr BYTE PUSH_EBP = 0x55;     // PUSH EBP
+        constexpr BYTE PUSH_ESI = 0x56;     // PUSH ESI
+        constexpr BYTE PUSH_EDI = 0x57;     // PUSH EDI
+
+        constexpr BYTE POP_EAX = 0x58;      // POP EAX
+        constexpr BYTE POP_ECX = 0x59;      // POP ECX
+        constexpr BYTE POP_EDX = 0x5A;      // POP EDX
+        constexpr BYTE POP_EBX = 0x5B;      // POP EBX
+        constexpr BYTE POP_ESP = 0x5C;      // POP ESP
+        constexpr BYTE POP_EBP = 0x5D;      // POP EBP
+        constexpr BYTE POP_ESI = 0x5E;      // POP ESI
+        constexpr BYTE POP_EDI = 0x5F;      // POP EDI
+
+        // Function operations
+        constexpr BYTE PUSHAD = 0x60;       // Push all general-purpose registers
+        constexpr BYTE POPAD = 0x61;        // Pop all general-purpose registers
+        constexpr BYTE PUSHFD = 0x9C;       // Push flags register
+        constexpr BYTE POPFD = 0x9D;        // Pop flags register
+        constexpr BYTE LEAVE = 0xC9;        // Leave (MOV ESP, EBP; POP EBP)
+        constexpr BYTE RET_IMM16 = 0xC2;    // RET immediate16
+        constexpr BYTE RETN = 0xC3;         // RET near (alias for RET)
+        constexpr BYTE RETF = 0xCB;         // RET far
+
+        // Test and logic
+        constexpr BYTE TEST_AL_IMM8 = 0xA8; // TEST AL, immediate8
+        constexpr BYTE TEST_EAX_IMM32 = 0xA9; // TEST EAX, immediate32
+        constexpr BYTE XOR_AL_IMM8 = 0x34;  // XOR AL, immediate8
+        constexpr BYTE XOR_EAX_IMM32 = 0x35; // XOR EAX, immediate32
+
+        // Interrupts and special
+        constexpr BYTE INT = 0xCD;          // Interrupt
+        constexpr BYTE INT3 = 0xCC;         // Breakpoint interrupt
+        constexpr BYTE HLT = 0xF4;          // Halt
+        constexpr BYTE CLC = 0xF8;          // Clear carry flag
+        constexpr BYTE STC = 0xF9;          // Set carry flag
+        constexpr BYTE CLI = 0xFA;          // Clear interrupt flag
+        constexpr BYTE STI = 0xFB;          // Set interrupt flag
+        constexpr BYTE CLD = 0xFC;          // Clear direction flag
+        constexpr BYTE STD = 0xFD;          // Set direction flag
+
+        // Prefix bytes
+        constexpr BYTE LOCK_PREFIX = 0xF0;  // Lock prefix
+        constexpr BYTE REP_PREFIX = 0xF3;   // Repeat prefix
+        constexpr BYTE REPNE_PREFIX = 0xF2; // Repeat while not equal prefix
+        constexpr BYTE CS_OVERRIDE = 0x2E;  // CS segment override
+        constexpr BYTE DS_OVERRIDE = 0x3E;  // DS segment override
+        constexpr BYTE ES_OVERRIDE = 0x26;  // ES segment override
+        constexpr BYTE FS_OVERRIDE = 0x64;  // FS segment override
+        constexpr BYTE GS_OVERRIDE = 0x65;  // GS segment override
+        constexpr BYTE SS_OVERRIDE = 0x36;  // SS segment override
+
+		// Basic 
+		constexpr BYTE MOV = 0x89;         // MOV r/m32, r32
+    }
+
+    namespace Console
+    {
+        FILE* Initialize(const char* title) noexcept
+        {
+            AllocConsole();
+            SetConsoleTitleA(title);
+            FILE* file;
+            freopen_s(&file, "CONOUT$", "w", stdout);
+            freopen_s(&file, "CONOUT$", "w", stderr);
+            freopen_s(&file, "CONIN$", "r", stdin);
+            return file;
+        }
+
+        void Free(FILE* file) noexcept
+        {
+            fclose(file);
+            FreeConsole();
+        }
+
+        void SetTitle(const char* title) noexcept
+        {
+            SetConsoleTitleA(title);
+        }
+
+        void SetColor(const WORD color) noexcept
+        {
+            SetConsoleTextAttribute(GetStdHandle(STD_OUTPUT_HANDLE), color);
+        }
+
+        void SetPosition(const short x, const short y) noexcept
+        {
+            SetConsoleCursorPosition(GetStdHandle(STD_OUTPUT_HANDLE), { x, y });
+        }
+
+        void Clear() noexcept
+        {
+            system("cls");
+        }
+
+        template<typename... T>
+        void Print(T... args)
+        {
+            (std::cout << ... << args) << std::endl;
+        }
+    }
+
+    namespace Matrix
+    {
+        struct Matrix4x4
+        {
+            float m[4][4];
+        };
+
+        struct Matrix3x4
+        {
+            float m[3][4];
+        };
+
+        struct Matrix3x3
+        {
+            float m[3][3];
+        };
+
+        struct Matrix2x2
+        {
+            float m[2][2];
+        };
+    }
+
+    namespace Vector
+    {
+        struct Vector2
+        {
+            float x, y;
+
+            Vector2 operator+(const Vector2& other) const noexcept
+            {
+                return { x + other.x, y + other.y };
+            }
+
+            Vector2 operator-(const Vector2& other) const noexcept
+            {
+                return { x - other.x, y - other.y };
+            }
+
+            Vector2 operator*(const Vector2& other) const noexcept
+            {
+                return { x * other.x, y * other.y };
+            }
+
+            Vector2 operator/(const Vector2& other) const noexcept
+            {
+                return { x / other.x, y / other.y };
+            }
+
+            Vector2 WorldToScreen(const Matrix::Matrix4x4& viewMatrix, const int windowWidth, const int windowHeight) const noexcept
+            {
+                Vector2 screen;
+                screen.x = viewMatrix.m[0][0] * x + viewMatrix.m[0][1] * y + viewMatrix.m[0][3];
+                screen.y = viewMatrix.m[1][0] * x + viewMatrix.m[1][1] * y + viewMatrix.m[1][3];
+                const float w = viewMatrix.m[3][0] * x + viewMatrix.m[3][1] * y + viewMatrix.m[3][3];
+                if (w < 0.01f)
+                    return { -1, -1 };
+                screen.x /= w;
+                screen.y /= w;
+                const float width = windowWidth / 2.0f;
+                const float height = windowHeight / 2.0f;
+                screen.x = width + 0.5f * screen.x * width + 0.5f;
+                screen.y = height - 0.5f * screen.y * height + 0.5f;
+                return screen;
+            }
+
+            Vector2 Transform(const Matrix::Matrix2x2& mat) const noexcept
+            {
+                return {
+                    mat.m[0][0] * x + mat.m[0][1] * y,
+                    mat.m[1][0] * x + mat.m[1][1] * y
+                };
+            }
+        };
+
+        struct Vector3
+        {
+            float x, y, z;
+
+            Vector3 operator+(const Vector3& other) const noexcept
+            {
+                return { x + other.x, y + other.y, z + other.z };
+            }
+
+            Vector3 operator-(const Vector3& other) const noexcept
+            {
+                return { x - other.x, y - other.y, z - other.z };
+            }
+
+            Vector3 operator*(const Vector3& other) const noexcept
+            {
+                return { x * other.x, y * other.y, z * other.z };
+            }
+
+            Vector3 operator/(const Vector3& other) const noexcept
+            {
+                return { x / other.x, y / other.y, z / other.z };
+            }
+
+            bool operator==(const Vector3& other) const noexcept
+            {
+                if (x == other.x && y == other.y && z == other.z)
+                    return true;
+                else
+                    return false;
+            }
+
+            Vector3 WorldToScreen(const Matrix::Matrix4x4& viewMatrix, int windowWidth, int windowHeight) const noexcept
+            {
+                Vector3 clip;
+                clip.x = viewMatrix.m[0][0] * x + viewMatrix.m[0][1] * y + viewMatrix.m[0][2] * z + viewMatrix.m[0][3];
+                clip.y = viewMatrix.m[1][0] * x + viewMatrix.m[1][1] * y + viewMatrix.m[1][2] * z + viewMatrix.m[1][3];
+                clip.z = viewMatrix.m[2][0] * x + viewMatrix.m[2][1] * y + viewMatrix.m[2][2] * z + viewMatrix.m[2][3];
+                float w = viewMatrix.m[3][0] * x + viewMatrix.m[3][1] * y + viewMatrix.m[3][2] * z + viewMatrix.m[3][3];
+
+                if (w < 0.001f)
+                    return { -1, -1, 0 };
+
+                clip.x /= w;
+                clip.y /= w;
+                clip.z /= w;
+
+                Vector3 screen;
+                screen.x = (clip.x * 0.5f + 0.5f) * windowWidth;
+                screen.y = (1.0f - (clip.y * 0.5f + 0.5f)) * windowHeight;
+                screen.z = clip.z;
+
+                return screen;
+            }
+
+            Vector3 WorldToScreen(const Matrix::Matrix3x4& viewMatrix, int windowWidth, int windowHeight) const noexcept
+            {
+                float clipX = viewMatrix.m[0][0] * x + viewMatrix.m[0][1] * y + viewMatrix.m[0][2] * z + viewMatrix.m[0][3];
+                float clipY = viewMatrix.m[1][0] * x + viewMatrix.m[1][1] * y + viewMatrix.m[1][2] * z + viewMatrix.m[1][3];
+                float clipZ = viewMatrix.m[2][0] * x + viewMatrix.m[2][1] * y + viewMatrix.m[2][2] * z + viewMatrix.m[2][3];
+                float clipW = viewMatrix.m[3][0] * x + viewMatrix.m[3][1] * y + viewMatrix.m[3][2] * z + viewMatrix.m[3][3];
+
+                if (clipW < 0.001f)
+                    return { -1, -1, 0 };
+
+                clipX /= clipW;
+                clipY /= clipW;
+                clipZ /= clipW;
+
+                Vector3 screen;
+                screen.x = (clipX * 0.5f + 0.5f) * windowWidth;
+                screen.y = (1.0f - (clipY * 0.5f + 0.5f)) * windowHeight;
+                screen.z = clipZ;
+
+                return screen;
+            }
+
+            Vector3 Transform(const Matrix::Matrix3x3& mat) const noexcept
+            {
+                return {
+                    mat.m[0][0] * x + mat.m[0][1] * y + mat.m[0][2] * z,
+                    mat.m[1][0] * x + mat.m[1][1] * y + mat.m[1][2] * z,
+                    mat.m[2][0] * x + mat.m[2][1] * y + mat.m[2][2] * z
+                };
+            }
+        };
+
+        struct Vector4
+        {
+            float x, y, z, w;
+
+            Vector4 operator+(const Vector4& other) const noexcept
+            {
+                return { x + other.x, y + other.y, z + other.z, w + other.w };
+            }
+
+            Vector4 operator-(const Vector4& other) const noexcept
+            {
+                return { x - other.x, y - other.y, z - other.z, w - other.w };
+            }
+
+            Vector4 operator*(const Vector4& other) const noexcept
+            {
+                return { x * other.x, y * other.y, z * other.z, w * other.w };
+            }
+
+            Vector4 operator/(const Vector4& other) const noexcept
+            {
+                return { x / other.x, y / other.y, z / other.z, w / other.w };
+            }
+
+            Vector4 operator*(const float value) const noexcept
+            {
+                return { x * value, y * value, z * value, w * value };
+            }
+
+            Vector4 operator/(const float value) const noexcept
+            {
+                return { x / value, y / value, z / value, w / value };
+            }
+
+            Vector4 WorldToScreen(const Matrix::Matrix4x4& viewMatrix, int windowWidth, int windowHeight) const noexcept
+            {
+                Vector4 clip;
+                clip.x = viewMatrix.m[0][0] * x + viewMatrix.m[0][1] * y + viewMatrix.m[0][2] * z + viewMatrix.m[0][3];
+                clip.y = viewMatrix.m[1][0] * x + viewMatrix.m[1][1] * y + viewMatrix.m[1][2] * z + viewMatrix.m[1][3];
+                clip.z = viewMatrix.m[2][0] * x + viewMatrix.m[2][1] * y + viewMatrix.m[2][2] * z + viewMatrix.m[2][3];
+                clip.w = viewMatrix.m[3][0] * x + viewMatrix.m[3][1] * y + viewMatrix.m[3][2] * z + viewMatrix.m[3][3];
+
+                if (clip.w < 0.001f)
+                    return { -1, -1, 0, 0 }; // Behind the camera
+
+                // Perspective divide → NDC
+                clip.x /= clip.w;
+                clip.y /= clip.w;
+                clip.z /= clip.w;
+
+                // Map from NDC [-1, 1] → screen [0, width], [0, height]
+                Vector4 screen;
+                screen.x = (clip.x * 0.5f + 0.5f) * windowWidth;
+                screen.y = (1.0f - (clip.y * 0.5f + 0.5f)) * windowHeight; // Flip Y
+                screen.z = clip.z; // Depth (0..1)
+                screen.w = clip.w; // Keep original W if you need it later
+                return screen;
+            }
+        };
+
+        float GetDistance(const Vector3& src, const Vector3& dst)
+        {
+            float dx = dst.x - src.x;
+            float dy = dst.y - src.y;
+            float dz = dst.z - src.z;
+            return sqrtf(dx * dx + dy * dy + dz * dz);
+        }
+
+        Vector3 CalcAngles(Vector3 src, Vector3 dst)
+        {
+            Vector3 angles = {};
+            Vector3 delta = dst - src;
+            float distance = GetDistance(src, dst);
+
+            // Edge case: Avoid division by zero
+            if (distance < 0.001f) {
+                return Vector3(0.0f, 0.0f, 0.0f);
+            }
+
+            angles.x = -atan2f(delta.x, delta.y) * (180.0f / PI) + 180.0f;
+
+            angles.y = asinf(delta.z / distance) * (180.0f / PI);
+
+            angles.z = 0.0f;
+
+            if (angles.x >= 360.0f) angles.x -= 360.0f;
+            if (angles.x < 0.0f) angles.x += 360.0f;
+
+            return angles;
+        }
+    }
+
+    namespace Scanner
+    {
+        // ----------------------- ASCII pattern compiler -----------------------
+        static inline int hexval(char c) {
+            if (c >= '0' && c <= '9') return c - '0';
+            c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+            if (c >= 'A' && c <= 'F') return 10 + (c - 'A');
+            return -1;
+        }
+        // Non-throwing core of the token parser; false on a malformed token.
+        static bool parse_byte_token(const std::string& tok, uint8_t& p, uint8_t& m) {
+            p = 0; m = 0;
+            if (tok == "?" || tok == "??") return true;
+            if (tok.size() != 2) return false;
+            const char hi = tok[0], lo = tok[1];
+            if (hi == '?') { /* upper wildcard */ }
+            else {
+                int v = hexval(hi); if (v < 0) return false;
+                p |= static_cast<uint8_t>(v << 4); m |= 0xF0;
+            }
+            if (lo == '?') { /* lower wildcard */ }
+            else {
+                int v = hexval(lo); if (v < 0) return false;
+                p |= static_cast<uint8_t>(v & 0x0F); m |= 0x0F;
+            }
+            return true;
+        }
+        static void push_byte_token(const std::string& tok, std::vector<uint8_t>& pat, std::vector<uint8_t>& mask) {
+            uint8_t p = 0, m = 0;
+            if (!parse_byte_token(tok, p, m)) throw std::runtime_error("Bad token: " + tok);
+            pat.push_back(p); mask.push_back(m);
+        }
+        struct MaskedPattern {
+            const uint8_t* pat;
+            const uint8_t* mask; // per-byte bitmask (0xFF exact, 0xF0 upper-only, 0x0F lower-only, 0x00 wildcard)
+            size_t len;
+        };
+        // Non-throwing variant of compile_ascii_pattern; on failure *error (if given) says why.
+        static bool parse_ascii_pattern(const std::string& ascii,
+            std::vector<uint8_t>& pat_out,
+            std::vector<uint8_t>& mask_out,
+            std::string* error = nullptr)
+        {
+            pat_out.clear(); mask_out.clear();
+            std::string tok; tok.reserve(4);
+            for (size_t i = 0; i < ascii.size();) {
+                while (i < ascii.size() && std::isspace(static_cast<unsigned char>(ascii[i]))) ++i;
+                if (i >= ascii.size()) break;
+                size_t j = i;
+                while (j < ascii.size() && !std::isspace(static_cast<unsigned char>(ascii[j]))) ++j;
+                tok = ascii.substr(i, j - i);
+                for (char& c : tok) c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+                uint8_t p = 0, m = 0;
+                if (!parse_byte_token(tok, p, m)) {
+                    if (error) *error = "Bad token: " + tok;
+                    pat_out.clear(); mask_out.clear();
+                    return false;
+                }
+                pat_out.push_back(p); mask_out.push_back(m);
+                i = j;
+            }
+            if (pat_out.empty()) {
+                if (error) *error = "Empty ASCII pattern";
+                return false;
+            }
+            return true;
+        }
+        static MaskedPattern compile_ascii_pattern(const std::string& ascii,
+            std::vector<uint8_t>& pat_out,
+            std::vector<uint8_t>& mask_out)
+        {
+            std::string error;
+            if (!parse_ascii_pattern(ascii, pat_out, mask_out, &error)) throw std::runtime_error(error);
+            return MaskedPattern{ pat_out.data(), mask_out.data(), pat_out.size() };
+        }
+
+        // ----------------------- Horspool (wildcard-aware) -----------------------
+        // Tail anchor + bad-character shifts; depends only on the pattern, so it can be built once.
+        struct HorspoolTable {
+            ptrdiff_t tail = -1;            // last fully-known byte (mask 0xFF), -1 if none
+            std::array<size_t, 256> shift{};
+        };
+        static constexpr HorspoolTable build_horspool_table(const MaskedPattern& mp) {
+            HorspoolTable t;
+            const size_t m = mp.len;
+            for (ptrdiff_t i = (ptrdiff_t)m - 1; i >= 0; --i) if (mp.mask[i] == 0xFF) { t.tail = i; break; }
+            if (t.tail < 0) return t;
+            const ptrdiff_t tail = t.tail;
+
+            // A wildcard/nibble byte before the tail can line up with any haystack byte,
+            // so no shift may jump past the last one of them.
+            size_t max_shift = static_cast<size_t>(tail + 1);
+            for (ptrdiff_t i = tail - 1; i >= 0; --i) if (mp.mask[i] != 0xFF) { max_shift = static_cast<size_t>(tail - i); break; }
+
+            for (size_t& s : t.shift) s = max_shift; // std::array::fill is constexpr only from C++20
+            for (size_t i = 0; i < static_cast<size_t>(tail); ++i)
+                if (mp.mask[i] == 0xFF) t.shift[mp.pat[i]] = (std::min)(max_shift, static_cast<size_t>(tail - i));
+            return t;
+        }
+
+        static size_t find_horspool_masked(const uint8_t* hay, size_t n, const MaskedPattern& mp, const HorspoolTable& t) {
+            const size_t m = mp.len;
+            if (!m || n < m) return n;
+
+            if (t.tail < 0) { // no concrete anchor → linear masked compare
+                for (size_t pos = 0; pos <= n - m; ++pos) {
+                    size_t j = 0;
+                    for (; j < m; ++j) if (((hay[pos + j] ^ mp.pat[j]) & mp.mask[j]) != 0) break;
+                    if (j == m) return pos;
+                }
+                return n;
+            }
+
+            const ptrdiff_t tail = t.tail;
+            size_t pos = 0;
+            while (pos <= n - m) {
+                const uint8_t h = hay[pos + tail];
+                if (h == mp.pat[tail]) {
+                    ptrdiff_t j = (ptrdiff_t)m - 1;
+                    for (; j >= 0; --j)
+                        if (((hay[pos + j] ^ mp.pat[j]) & mp.mask[j]) != 0) break;
+                    if (j < 0) return pos;
+                }
+                pos += t.shift[h];
+            }
+            return n;
+        }
+
+        static size_t find_horspool_masked(const uint8_t* hay, size_t n, const MaskedPattern& mp) {
+            return find_horspool_masked(hay, n, mp, build_horspool_table(mp));
+        }
+
+        // ----------------------- SIMD masked kernels (runtime CPU dispatch) -----------------------
+        enum class Kernel { Scalar, SSE2, AVX2, AVX512 };
+
+        // Two pattern bytes probed for every candidate offset before the full masked compare.
+        // Fully-known bytes are preferred; nibble masks (0xF0 / 0x0F) work the same way since
+        // the haystack byte is ANDed with the mask before comparing.
+        struct Anchors {
+            size_t i0 = 0, i1 = 0;   // pattern indices
+            uint8_t v0 = 0, m0 = 0;  // (pat & mask), mask at i0
+            uint8_t v1 = 0, m1 = 0;  // (pat & mask), mask at i1
+            bool any = false;        // false → every byte is a wildcard
+        };
+        static constexpr Anchors pick_anchors(const MaskedPattern& mp) {
+            Anchors a;
+            ptrdiff_t first = -1, last = -1;
+            for (size_t i = 0; i < mp.len; ++i) if (mp.mask[i] == 0xFF) { if (first < 0) first = (ptrdiff_t)i; last = (ptrdiff_t)i; }
+            if (first < 0)
+                for (size_t i = 0; i < mp.len; ++i) if (mp.mask[i] != 0x00) { if (first < 0) first = (ptrdiff_t)i; last = (ptrdiff_t)i; }
+            if (first < 0) return a;
+            a.any = true;
+            a.i0 = static_cast<size_t>(first); a.m0 = mp.mask[a.i0]; a.v0 = mp.pat[a.i0] & a.m0;
+            a.i1 = static_cast<size_t>(last);  a.m1 = mp.mask[a.i1]; a.v1 = mp.pat[a.i1] & a.m1;
+            return a;
+        }
+
+        // Everything the kernels precompute from a pattern: SIMD anchors and the scalar shift table.
+        struct ScanPlan {
+            Anchors anchors;
+            HorspoolTable horspool;
+            bool memchr_anchor = false; // scalar path: memchr for anchors.v0 instead of Horspool
+        };
+        static constexpr ScanPlan make_plan(const MaskedPattern& mp) {
+            return ScanPlan{ pick_anchors(mp), build_horspool_table(mp) };
+        }
+
+        static inline bool match_at(const uint8_t* p, const MaskedPattern& mp) {
+            for (size_t j = 0; j < mp.len; ++j) if (((p[j] ^ mp.pat[j]) & mp.mask[j]) != 0) return false;
+            return true;
+        }
+
+        // Scalar finish for the last few offsets that don't fill a whole vector.
+        static size_t find_masked_tail(const uint8_t* hay, size_t n, const MaskedPattern& mp, size_t pos) {
+            for (; pos <= n - mp.len; ++pos) if (match_at(hay + pos, mp)) return pos;
+            return n;
+        }
+
+        // Scalar path for a rare, fully-known anchor byte: libc memchr is vectorized and skips
+        // straight to the next occurrence, then the whole pattern is verified there.
+        static size_t find_masked_memchr(const uint8_t* hay, size_t n, const MaskedPattern& mp, const Anchors& a) {
+            const size_t m = mp.len;
+            if (!m || n < m) return n;
+            const uint8_t* p = hay + a.i0;
+            const uint8_t* end = p + (n - m + 1);
+            while (p < end) {
+                p = static_cast<const uint8_t*>(std::memchr(p, a.v0, static_cast<size_t>(end - p)));
+                if (!p) return n;
+                const size_t at = static_cast<size_t>(p - hay) - a.i0;
+                if (match_at(hay + at, mp)) return at;
+                ++p;
+            }
+            return n;
+        }
+
+        // Each kernel tests W consecutive offsets per iteration: both anchor bytes are loaded
+        // unaligned at (pos + i0) / (pos + i1), masked, compared, and the surviving lanes are
+        // verified lowest-first, so the result is always the leftmost match.
+        IMH_TARGET("sse2")
+        static size_t find_masked_sse2(const uint8_t* hay, size_t n, const MaskedPattern& mp, const Anchors& a) {
+            const size_t m = mp.len;
+            if (!m || n < m) return n;
+            if (!a.any) return 0;
+            const size_t count = n - m + 1; // candidate offsets
+            const __m128i m0 = _mm_set1_epi8(static_cast<char>(a.m0)), v0 = _mm_set1_epi8(static_cast<char>(a.v0));
+            const __m128i m1 = _mm_set1_epi8(static_cast<char>(a.m1)), v1 = _mm_set1_epi8(static_cast<char>(a.v1));
+            size_t pos = 0;
+            for (; pos + 16 <= count; pos += 16) {
+                const __m128i h0 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(hay + pos + a.i0));
+                const __m128i h1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(hay + pos + a.i1));
+                const __m128i eq = _mm_and_si128(_mm_cmpeq_epi8(_mm_and_si128(h0, m0), v0),
+                                                 _mm_cmpeq_epi8(_mm_and_si128(h1, m1), v1));
+                uint32_t bits = static_cast<uint32_t>(_mm_movemask_epi8(eq));
+                while (bits) {
+                    const size_t at = pos + Helpers::CountTrailingZeros(bits);
+                    if (match_at(hay + at, mp)) return at;
+                    bits &= bits - 1;
+                }
+            }
+            return find_masked_tail(hay, n, mp, pos);
+        }
+
+        IMH_TARGET("avx2")
+        static size_t find_masked_avx2(const uint8_t* hay, size_t n, const MaskedPattern& mp, const Anchors& a) {
+            const size_t m = mp.len;
+            if (!m || n < m) return n;
+            if (!a.any) return 0;
+            const size_t count = n - m + 1;
+            const __m256i m0 = _mm256_set1_epi8(static_cast<char>(a.m0)), v0 = _mm256_set1_epi8(static_cast<char>(a.v0));
+            const __m256i m1 = _mm256_set1_epi8(static_cast<char>(a.m1)), v1 = _mm256_set1_epi8(static_cast<char>(a.v1));
+            size_t pos = 0;
+            for (; pos + 32 <= count; pos += 32) {
+                const __m256i h0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(hay + pos + a.i0));
+                const __m256i h1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(hay + pos + a.i1));
+                const __m256i eq = _mm256_and_si256(_mm256_cmpeq_epi8(_mm256_and_si256(h0, m0), v0),
+                                                    _mm256_cmpeq_epi8(_mm256_and_si256(h1, m1), v1));
+                uint32_t bits = static_cast<uint32_t>(_mm256_movemask_epi8(eq));
+                while (bits) {
+                    const size_t at = pos + Helpers::CountTrailingZeros(bits);
+                    if (match_at(hay + at, mp)) return at;
+                    bits &= bits - 1;
+                }
+            }
+            return find_masked_tail(hay, n, mp, pos);
+        }
+
+        IMH_TARGET("avx512f,avx512bw")
+        static size_t find_masked_avx512(const uint8_t* hay, size_t n, const MaskedPattern& mp, const Anchors& a) {
+            const size_t m = mp.len;
+            if (!m || n < m) return n;
+            if (!a.any) return 0;
+            const size_t count = n - m + 1;
+            const __m512i m0 = _mm512_set1_epi8(static_cast<char>(a.m0)), v0 = _mm512_set1_epi8(static_cast<char>(a.v0));
+            const __m512i m1 = _mm512_set1_epi8(static_cast<char>(a.m1)), v1 = _mm512_set1_epi8(static_cast<char>(a.v1));
+            size_t pos = 0;
+            for (; pos + 64 <= count; pos += 64) {
+                const __m512i h0 = _mm512_loadu_si512(reinterpret_cast<const void*>(hay + pos + a.i0));
+                const __m512i h1 = _mm512_loadu_si512(reinterpret_cast<const void*>(hay + pos + a.i1));
+                uint64_t bits = _mm512_cmpeq_epi8_mask(_mm512_and_si512(h0, m0), v0)
+                              & _mm512_cmpeq_epi8_mask(_mm512_and_si512(h1, m1), v1);
+                while (bits) {
+                    const size_t at = pos + Helpers::CountTrailingZeros(bits);
+                    if (match_at(hay + at, mp)) return at;
+                    bits &= bits - 1;
+                }
+            }
+            return find_masked_tail(hay, n, mp, pos);
+        }
+
+        static bool kernel_supported(Kernel k) {
+            const auto& cpu = Helpers::GetCpuFeatures();
+            switch (k) {
+            case Kernel::Scalar: return true;
+            case Kernel::SSE2:   return cpu.sse2;
+            case Kernel::AVX2:   return cpu.avx2;
+            case Kernel::AVX512: return cpu.avx512bw;
+            }
+            return false;
+        }
+        static const char* kernel_name(Kernel k) {
+            switch (k) {
+            case Kernel::Scalar: return "scalar";
+            case Kernel::SSE2:   return "sse2";
+            case Kernel::AVX2:   return "avx2";
+            case Kernel::AVX512: return "avx512";
+            }
+            return "?";
+        }
+        static Kernel best_kernel() {
+            static const Kernel k = kernel_supported(Kernel::AVX512) ? Kernel::AVX512
+                                  : kernel_supported(Kernel::AVX2) ? Kernel::AVX2
+                                  : kernel_supported(Kernel::SSE2) ? Kernel::SSE2
+                                  : Kernel::Scalar;
+            return k;
+        }
+
+        // Returns the offset of the first match, or n when there is none (same contract as find_horspool_masked).
+        static size_t find_masked(const uint8_t* hay, size_t n, const MaskedPattern& mp, const ScanPlan& plan, Kernel k) {
+            switch (k) {
+            case Kernel::SSE2:   return find_masked_sse2(hay, n, mp, plan.anchors);
+            case Kernel::AVX2:   return find_masked_avx2(hay, n, mp, plan.anchors);
+            case Kernel::AVX512: return find_masked_avx512(hay, n, mp, plan.anchors);
+            default:
+                if (plan.memchr_anchor) return find_masked_memchr(hay, n, mp, plan.anchors);
+                return find_horspool_masked(hay, n, mp, plan.horspool);
+            }
+        }
+        static size_t find_masked(const uint8_t* hay, size_t n, const MaskedPattern& mp, const ScanPlan& plan) {
+            return find_masked(hay, n, mp, plan, best_kernel());
+        }
+        static size_t find_masked(const uint8_t* hay, size_t n, const MaskedPattern& mp, Kernel k) {
+            switch (k) {
+            case Kernel::SSE2:   return find_masked_sse2(hay, n, mp, pick_anchors(mp));
+            case Kernel::AVX2:   return find_masked_avx2(hay, n, mp, pick_anchors(mp));
+            case Kernel::AVX512: return find_masked_avx512(hay, n, mp, pick_anchors(mp));
+            default:             return find_horspool_masked(hay, n, mp);
+            }
+        }
+        static size_t find_masked(const uint8_t* hay, size_t n, const MaskedPattern& mp) {
+            return find_masked(hay, n, mp, best_kernel());
+        }
+
+        // ----------------------- Byte-frequency tuned plans -----------------------
+        // The default plan anchors on the first/last known bytes, which in x86 code are often
+        // 0x48, 0x8B, 0x00 or 0xCC and fire on nearly every vector. With a histogram of the range
+        // being scanned the two statistically rarest known bytes become the SIMD anchors instead,
+        // and the scalar path jumps between occurrences of the rarest byte with memchr.
+        struct ByteHistogram {
+            std::array<uint64_t, 256> count{};
+            uint64_t total = 0;
+        };
+
+        // Counts everything up to 1 MiB; larger ranges are sampled in 16 evenly spaced 64 KiB blocks.
+        static ByteHistogram build_byte_histogram(const uint8_t* p, size_t n) {
+            ByteHistogram h;
+            if (!p || !n) return h;
+            constexpr size_t full_limit = size_t(1) << 20, block = size_t(64) << 10, blocks = 16;
+            // Four interleaved tables avoid store-to-load stalls on runs of the same byte.
+            std::array<std::array<uint64_t, 256>, 4> c{};
+            auto count_block = [&](const uint8_t* b, size_t len) {
+                size_t i = 0;
+                for (; i + 4 <= len; i += 4) { ++c[0][b[i]]; ++c[1][b[i + 1]]; ++c[2][b[i + 2]]; ++c[3][b[i + 3]]; }
+                for (; i < len; ++i) ++c[0][b[i]];
+                h.total += len;
+            };
+            if (n <= full_limit) count_block(p, n);
+            else {
+                const size_t stride = (n - block) / (blocks - 1);
+                for (size_t k = 0; k < blocks; ++k) count_block(p + k * stride, block);
+            }
+            for (size_t b = 0; b < 256; ++b) h.count[b] = c[0][b] + c[1][b] + c[2][b] + c[3][b];
+            return h;
+        }
+
+        // How often (pat & mask) shows up under mask; exact byte for 0xFF, summed for nibble masks.
+        static uint64_t masked_frequency(const ByteHistogram& h, uint8_t value, uint8_t mask) {
+            if (mask == 0xFF) return h.count[value];
+            uint64_t f = 0;
+            for (size_t b = 0; b < 256; ++b) if ((static_cast<uint8_t>(b) & mask) == value) f += h.count[b];
+            return f;
+        }
+
+        // i0 = rarest known byte, i1 = next rarest (same index if only one byte is known).
+        static Anchors pick_rare_anchors(const MaskedPattern& mp, const ByteHistogram& h) {
+            if (!h.total) return pick_anchors(mp);
+            Anchors a;
+            constexpr size_t none = SIZE_MAX;
+            size_t best0 = none, best1 = none;
+            uint64_t f0 = UINT64_MAX, f1 = UINT64_MAX;
+            for (size_t i = 0; i < mp.len; ++i) {
+                if (!mp.mask[i]) continue;
+                const uint64_t f = masked_frequency(h, mp.pat[i] & mp.mask[i], mp.mask[i]);
+                if (f < f0) { best1 = best0; f1 = f0; best0 = i; f0 = f; }
+                else if (f < f1) { best1 = i; f1 = f; }
+            }
+            if (best0 == none) return a;
+            if (best1 == none) best1 = best0;
+            a.any = true;
+            a.i0 = best0; a.m0 = mp.mask[best0]; a.v0 = mp.pat[best0] & a.m0;
+            a.i1 = best1; a.m1 = mp.mask[best1]; a.v1 = mp.pat[best1] & a.m1;
+            return a;
+        }
+
+        static ScanPlan make_plan(const MaskedPattern& mp, const ByteHistogram& h) {
+            ScanPlan plan = make_plan(mp);
+            if (!h.total) return plan;
+            plan.anchors = pick_rare_anchors(mp, h);
+            // Horspool only skips far when its tail byte is rare; otherwise memchr on the rarest byte wins.
+            if (plan.anchors.any && plan.anchors.m0 == 0xFF) {
+                const uint64_t tail_freq = plan.horspool.tail >= 0 ? h.count[mp.pat[plan.horspool.tail]] : h.total;
+                plan.memchr_anchor = h.count[plan.anchors.v0] * 4 < tail_freq;
+            }
+            return plan;
+        }
+
+        // ----------------------- Post-processing steps -----------------------
+        // What to do with a match before handing it back, so call sites stop repeating
+        // "add 3, read rel32, add 7, dereference". Steps run in order on the address; any step
+        // that cannot read its input yields 0. Reads are checked against VirtualQuery'd page
+        // state and never flip protection.
+        // example: static const auto sig = IMH::Scanner::Signature("48 8B 05 ?? ?? ?? ?? 48 85 C0")
+        //              .rip().deref();                // the global the mov loads from, then its value
+        //          uintptr_t obj = IMH::Scanner::patternscan("game.dll", sig);
+        struct PostStep {
+            enum Kind : uint8_t {
+                Offset,   // addr += value
+                Rel32,    // addr = addr + length + *(int32*)(addr + value)
+                Resolve,  // target of the branch / RIP-relative operand of the instruction at addr
+                Deref,    // addr = *(uintptr_t*)addr, value times
+                Cast      // addr = value-byte integer read at addr (sign-extended when length != 0)
+            };
+            Kind kind = Offset;
+            int64_t value = 0;
+            uint8_t length = 0;
+        };
+
+        static constexpr PostStep post_offset(int64_t delta) { return { PostStep::Offset, delta, 0 }; }
+        static constexpr PostStep post_rel32(size_t disp_at, size_t insn_len) { return { PostStep::Rel32, static_cast<int64_t>(disp_at), static_cast<uint8_t>(insn_len) }; }
+        static constexpr PostStep post_resolve() { return { PostStep::Resolve, 0, 0 }; }
+        static constexpr PostStep post_deref(size_t times = 1) { return { PostStep::Deref, static_cast<int64_t>(times), 0 }; }
+        static constexpr PostStep post_cast(size_t width, bool sign_extend = false) { return { PostStep::Cast, static_cast<int64_t>(width), static_cast<uint8_t>(sign_extend) }; }
+
+        // ----------------------- Compiled signatures -----------------------
+        // Parses and validates an ASCII pattern once and keeps the kernel plan (anchor bytes and
+        // masks the SIMD kernels broadcast, Horspool shift table) next to it. Immutable after
+        // construction, so one instance can be shared by any number of threads and scans.
+        // example: static const IMH::Scanner::Signature sig("48 8B 05 ?? ?? ?? ?? 48 85 C0");
+        //          if (sig.valid()) addr = IMH::Scanner::patternscan("game.dll", sig);
+        class Signature {
+        public:
+            Signature() = default;
+            // Never throws on bad input: check valid() / error().
+            explicit Signature(const std::string& ascii) {
+                if (!parse_ascii_pattern(ascii, pat, mask, &err)) return;
+                plan = make_plan(pattern());
+            }
+            Signature(const std::string& ascii, std::vector<PostStep> steps) : Signature(ascii) { post = std::move(steps); }
+
+            // Post-processing applied by patternscan after the match (see PostStep). Each builder
+            // returns a new Signature with the step appended; *this is never modified.
+            Signature then(const PostStep& s) const { Signature copy(*this); copy.post.push_back(s); return copy; }
+            Signature offset(int64_t delta) const { return then(post_offset(delta)); }
+            Signature rel32(size_t disp_at, size_t insn_len) const { return then(post_rel32(disp_at, insn_len)); }
+            Signature rip() const { return then(post_resolve()); }
+            Signature deref(size_t times = 1) const { return then(post_deref(times)); }
+            Signature cast(size_t width, bool sign_extend = false) const { return then(post_cast(width, sign_extend)); }
+            const std::vector<PostStep>& post_steps() const { return post; }
+
+            bool valid() const { return !pat.empty(); }
+            const std::string& error() const { return err; }
+            size_t size() const { return pat.size(); }
+            MaskedPattern pattern() const { return { pat.data(), mask.data(), pat.size() }; }
+            const ScanPlan& scan_plan() const { return plan; }
+
+            // Offset of the first match in [hay, hay + n), or n.
+            size_t find(const uint8_t* hay, size_t n) const {
+                if (!valid()) return n;
+                return find_masked(hay, n, pattern(), plan);
+            }
+            bool matches(const uint8_t* p) const { return valid() && match_at(p, pattern()); }
+
+        private:
+            std::vector<uint8_t> pat, mask;
+            ScanPlan plan;
+            std::vector<PostStep> post;
+            std::string err;
+        };
+
+        // ----------------------- Applying post-processing -----------------------
+        // Readability of the pages touched while post-processing a batch: one VirtualQuery per
+        // region, reused by every later step and signature that lands in the same region. The
+        // answer can go stale, so reads still go through Memory::GuardedCopy.
+        class PageProbe {
+        public:
+            bool readable(uintptr_t addr, size_t len) {
+                if (!Helpers::IsValidAddr(addr) || addr + len < addr) return false;
+                const uintptr_t end = addr + len;
+                while (addr < end) {
+                    const Known* k = lookup(addr);
+                    if (!k || !k->readable) return false;
+                    addr = k->end;
+                }
+                return true;
+            }
+
+            template<typename T>
+            bool read(uintptr_t addr, T& out) {
+                if (!readable(addr, sizeof(T))) return false;
+                return Memory::GuardedCopy(&out, reinterpret_cast<const void*>(addr), sizeof(T));
+            }
+
+        private:
+            struct Known { uintptr_t base, end; bool readable; };
+
+            const Known* lookup(uintptr_t addr) {
+                for (const Known& k : known) if (addr >= k.base && addr < k.end) return &k;
+                MEMORY_BASIC_INFORMATION mbi{};
+                if (!VirtualQuery(reinterpret_cast<LPCVOID>(addr), &mbi, sizeof(mbi)) || !mbi.RegionSize) return nullptr;
+                const uintptr_t base = reinterpret_cast<uintptr_t>(mbi.BaseAddress);
+                known.push_back({ base, base + mbi.RegionSize, mbi.State == MEM_COMMIT && Memory::IsReadableProtect(mbi.Protect) });
+                return &known.back();
+            }
+
+            std::vector<Known> known;
+        };
+
+        // 0F xx opcodes that are followed by a ModRM byte (0F 38 / 0F 3A are handled separately;
+        // 0F 0F, 3DNow!, has a trailing opcode byte and is reported as unknown).
+        static constexpr bool two_byte_has_modrm(uint8_t op) {
+            if (op >= 0x80 && op <= 0x8F) return false;  // jcc rel32
+            if (op >= 0xC8 && op <= 0xCF) return false;  // bswap
+            if (op >= 0x30 && op <= 0x37) return false;  // wrmsr, rdtsc, sysenter, ...
+            switch (op) {
+            case 0x05: case 0x06: case 0x07: case 0x08: case 0x09: case 0x0B: case 0x0E: case 0x0F:
+            case 0x77: case 0xA0: case 0xA1: case 0xA2: case 0xA8: case 0xA9: case 0xAA:
+                return false;
+            default:
+                return true;
+            }
+        }
+
+        // Target of the instruction at addr: CALL/JMP rel32 (ByteCodes::CALL/JMP), short jumps and
+        // jcc rel8/rel32, or the RIP-relative memory operand (ModRM mod=00 rm=101) of a one-, two-
+        // or three-byte opcode, accounting for a trailing immediate. 0 if not recognized, including
+        // opcodes whose immediate size is not known (a guess would return a wrong address).
+        static uintptr_t decode_relative_target(uintptr_t addr, PageProbe& probe) {
+            uint8_t b[16] = {};
+            size_t avail = 0;
+            while (avail < sizeof(b) && probe.readable(addr + avail, 1)) ++avail;
+            if (avail && !Memory::GuardedCopy(b, reinterpret_cast<const void*>(addr), avail)) {
+                // a page went away after the probe: keep the part on addr's own page if it still copies
+                const size_t first = (std::min)(avail, static_cast<size_t>(4096 - (addr & 4095)));
+                avail = first < avail && Memory::GuardedCopy(b, reinterpret_cast<const void*>(addr), first) ? first : 0;
+            }
+            auto rel32_at = [&](size_t at, size_t len) -> uintptr_t {
+                if (at + 4 > avail) return 0;
+                int32_t d; std::memcpy(&d, b + at, 4);
+                return addr + len + static_cast<intptr_t>(d);
+            };
+            if (avail < 2) return 0;
+
+            if (b[0] == ByteCodes::CALL || b[0] == ByteCodes::JMP) return rel32_at(1, 5);
+            if (b[0] == ByteCodes::JMP_SHORT || (b[0] >= 0x70 && b[0] <= 0x7F)) return addr + 2 + static_cast<int8_t>(b[1]);
+            if (b[0] == 0x0F && (b[1] & 0xF0) == 0x80) return rel32_at(2, 6);
+
+            size_t i = 0;
+            bool opsize16 = false;
+            auto is_prefix = [](uint8_t p) {
+                return p == 0x66 || p == 0x67 || p == 0xF0 || p == 0xF2 || p == 0xF3 ||
+                       p == 0x26 || p == 0x2E || p == 0x36 || p == 0x3E || p == 0x64 || p == 0x65;
+            };
+            while (i < avail && is_prefix(b[i])) opsize16 |= b[i] == 0x66, ++i;
+            if (i < avail && (b[i] & 0xF0) == 0x40) ++i; // REX
+            if (i + 1 >= avail) return 0;
+
+            const uint8_t op = b[i];
+            size_t imm = 0;
+            size_t modrm_at = i + 1;
+            if (op == 0x0F) {
+                const uint8_t op2 = b[i + 1];
+                if (op2 == 0x38 || op2 == 0x3A) { // three-byte opcode, ModRM after the third byte
+                    modrm_at = i + 3;
+                    imm = op2 == 0x3A ? 1 : 0;
+                }
+                else {
+                    if (!two_byte_has_modrm(op2)) return 0;
+                    modrm_at = i + 2;
+                    switch (op2) {
+                    case 0x70: case 0x71: case 0x72: case 0x73: // pshuf*, shift groups
+                    case 0xA4: case 0xAC:                       // shld/shrd r/m, r, imm8
+                    case 0xBA:                                  // bt* r/m, imm8
+                    case 0xC2: case 0xC4: case 0xC5: case 0xC6: // cmpps, pinsrw, pextrw, shufps
+                        imm = 1; break;
+                    default: break;
+                    }
+                }
+            }
+            else {
+                if (modrm_at >= avail) return 0;
+                const uint8_t reg = (b[modrm_at] >> 3) & 7;
+                if ((op <= 0x3B && (op & 7) < 4) || op == 0x63 || (op >= 0x84 && op <= 0x8F) ||
+                    (op >= 0xD0 && op <= 0xD3) || (op >= 0xD8 && op <= 0xDF) || op == 0xFE || op == 0xFF)
+                    imm = 0;  // ALU r/m forms, movsxd, test/xchg/mov/lea/pop, shifts by 1/cl, x87, inc/dec/call/jmp/push
+                else {
+                    switch (op) {
+                    case 0x6B: case 0x80: case 0x83: case 0xC0: case 0xC1: case 0xC6: imm = 1; break;
+                    case 0x69: case 0x81: case 0xC7: imm = opsize16 ? 2 : 4; break;
+                    case 0xF6: imm = reg <= 1 ? 1 : 0; break;                  // test r/m8, imm8 (/0, alias /1)
+                    case 0xF7: imm = reg <= 1 ? (opsize16 ? 2 : 4) : 0; break; // test r/m, imm16/32
+                    default: return 0; // no ModRM, VEX/EVEX, or an immediate size we do not know
+                    }
+                }
+            }
+            if (modrm_at >= avail || (b[modrm_at] & 0xC7) != 0x05) return 0;
+            return rel32_at(modrm_at + 1, modrm_at + 5 + imm);
+        }
+
+        static uintptr_t apply_post_steps(uintptr_t addr, const std::vector<PostStep>& steps, PageProbe& probe) {
+            for (const PostStep& s : steps) {
+                if (!addr) return 0;
+                switch (s.kind) {
+                case PostStep::Offset:
+                    addr = static_cast<uintptr_t>(static_cast<intptr_t>(addr) + static_cast<intptr_t>(s.value));
+                    break;
+                case PostStep::Rel32: {
+                    int32_t d = 0;
+                    if (!probe.read(addr + static_cast<uintptr_t>(s.value), d)) return 0;
+                    addr = addr + s.length + static_cast<intptr_t>(d);
+                    break;
+                }
+                case PostStep::Resolve:
+                    addr = decode_relative_target(addr, probe);
+                    break;
+                case PostStep::Deref:
+                    for (int64_t k = 0; k < s.value && addr; ++k)
+                        if (!probe.read(addr, addr)) return 0;
+                    break;
+                case PostStep::Cast: {
+                    uint64_t v = 0;
+                    switch (s.value) {
+                    case 1: { uint8_t x;  if (!probe.read(addr, x)) return 0; v = s.length ? uint64_t(int64_t(int8_t(x)))  : x; break; }
+                    case 2: { uint16_t x; if (!probe.read(addr, x)) return 0; v = s.length ? uint64_t(int64_t(int16_t(x))) : x; break; }
+                    case 4: { uint32_t x; if (!probe.read(addr, x)) return 0; v = s.length ? uint64_t(int64_t(int32_t(x))) : x; break; }
+                    case 8: { uint64_t x; if (!probe.read(addr, x)) return 0; v = x; break; }
+                    default: return 0;
+                    }
+                    addr = static_cast<uintptr_t>(v);
+                    break;
+                }
+                }
+            }
+            return addr;
+        }
+
+        static uintptr_t apply_post_steps(uintptr_t addr, const std::vector<PostStep>& steps) {
+            if (!addr || steps.empty()) return addr;
+            PageProbe probe;
+            return apply_post_steps(addr, steps, probe);
+        }
+
+        // ----------------------- Compile-time signatures -----------------------
+        // "48 8B ?? ?? 74 0A"_sig is parsed by the compiler into fixed-size pattern/mask arrays
+        // plus a precomputed ScanPlan; a malformed token fails the build instead of scanning for
+        // nothing. The object needs no heap and plugs into the same kernels as Signature.
+        // example: using namespace IMH::Scanner::literals;
+        //          constexpr auto sig = "48 8B 05 ?? ?? ?? ?? 48 85 C0 74 ?? E8"_sig;
+        //          uintptr_t addr = IMH::Scanner::patternscan("game.dll", sig);
+        // The literal needs C++20 (consteval, class-type template parameters); without it the
+        // header still builds (it needs C++17), only "..."_sig is left out.
+        template<size_t Len>
+        struct StaticSignature {
+            std::array<uint8_t, Len> pat{};
+            std::array<uint8_t, Len> mask{};
+            ScanPlan plan{};
+
+            static constexpr size_t size() { return Len; }
+            constexpr MaskedPattern pattern() const { return { pat.data(), mask.data(), Len }; }
+            constexpr const ScanPlan& scan_plan() const { return plan; }
+            constexpr bool valid() const { return true; }
+
+            size_t find(const uint8_t* hay, size_t n) const { return find_masked(hay, n, pattern(), plan); }
+            bool matches(const uint8_t* p) const { return match_at(p, pattern()); }
+        };
+
+#if defined(__cpp_consteval) && defined(__cpp_nontype_template_args) && __cpp_nontype_template_args >= 201911L
+        template<size_t N>
+        struct SignatureString {
+            char chars[N]{};
+            consteval SignatureString(const char(&s)[N]) { for (size_t i = 0; i < N; ++i) chars[i] = s[i]; }
+        };
+
+        // Not constexpr on purpose: reaching it during constant evaluation is the compile error.
+        inline void invalid_signature_token() {}
+
+        static constexpr bool is_sig_space(char c) { return c == ' ' || c == '\t' || c == '\n' || c == '\r'; }
+        static constexpr int sig_hexval(char c) {
+            if (c >= '0' && c <= '9') return c - '0';
+            if (c >= 'a' && c <= 'f') return 10 + (c - 'a');
+            if (c >= 'A' && c <= 'F') return 10 + (c - 'A');
+            return -1;
+        }
+
+        template<size_t N>
+        consteval size_t count_signature_tokens(const SignatureString<N>& s) {
+            size_t count = 0;
+            for (size_t i = 0; i + 1 < N;) {
+                while (i + 1 < N && is_sig_space(s.chars[i])) ++i;
+                if (i + 1 >= N) break;
+                ++count;
+                while (i + 1 < N && !is_sig_space(s.chars[i])) ++i;
+            }
+            if (count == 0) invalid_signature_token(); // empty pattern
+            return count;
+        }
+
+        template<size_t Len, size_t N>
+        consteval StaticSignature<Len> parse_static_signature(const SignatureString<N>& s) {
+            StaticSignature<Len> sig{};
+            size_t t = 0;
+            for (size_t i = 0; i + 1 < N;) {
+                while (i + 1 < N && is_sig_space(s.chars[i])) ++i;
+                if (i + 1 >= N) break;
+                size_t j = i;
+                while (j + 1 < N && !is_sig_space(s.chars[j])) ++j;
+                const size_t len = j - i;
+                uint8_t p = 0, m = 0;
+                if (len == 1 && s.chars[i] == '?') { /* full wildcard */ }
+                else if (len == 2) {
+                    const char hi = s.chars[i], lo = s.chars[i + 1];
+                    if (hi != '?') {
+                        const int v = sig_hexval(hi);
+                        if (v < 0) invalid_signature_token();
+                        p |= static_cast<uint8_t>(v << 4); m |= 0xF0;
+                    }
+                    if (lo != '?') {
+                        const int v = sig_hexval(lo);
+                        if (v < 0) invalid_signature_token();
+                        p |= static_cast<uint8_t>(v & 0x0F); m |= 0x0F;
+                    }
+                }
+                else invalid_signature_token();
+                sig.pat[t] = p; sig.mask[t] = m; ++t;
+                i = j;
+            }
+            sig.plan = make_plan(sig.pattern());
+            return sig;
+        }
+
+        namespace literals {
+            template<SignatureString S>
+            consteval auto operator""_sig() {
+                return parse_static_signature<count_signature_tokens(S)>(S);
+            }
+        }
+#endif
+
+        // ----------------------- Kernel benchmark -----------------------
+        // Fills a buffer with common x86-64 instruction encodings (prologues, RIP-relative movs,
+        // calls, short jumps, int3 padding) so anchor hit rates resemble a real .text section.
+        static std::vector<uint8_t> make_synthetic_code(size_t bytes, uint32_t seed = 0x9E3779B9u) {
+            static const std::vector<std::vector<int>> frags = {
+                { 0x48, 0x89, 0x5C, 0x24, 0x08 },       // mov [rsp+8], rbx
+                { 0x40, 0x53 },                         // push rbx
+                { 0x48, 0x83, 0xEC, 0x20 },             // sub rsp, 20h
+                { 0x48, 0x8B, 0x05, -1, -1, -1, -1 },   // mov rax, [rip+rel32]
+                { 0x48, 0x8B, 0x0D, -1, -1, -1, -1 },   // mov rcx, [rip+rel32]
+                { 0xE8, -1, -1, -1, -1 },               // call rel32
+                { 0x48, 0x85, 0xC0 },                   // test rax, rax
+                { 0x74, -1 },                           // je rel8
+                { 0x0F, 0x84, -1, -1, 0x00, 0x00 },     // je rel32
+                { 0x33, 0xC0 },                         // xor eax, eax
+                { 0x48, 0x8B, 0xCB },                   // mov rcx, rbx
+                { 0x89, 0x44, 0x24, -1 },               // mov [rsp+disp8], eax
+                { 0x8B, 0x4F, -1 },                     // mov ecx, [rdi+disp8]
+                { 0x48, 0x83, 0xC4, 0x20, 0x5B, 0xC3 }, // add rsp, 20h; pop rbx; ret
+                { 0xCC, 0xCC, 0xCC, 0xCC },             // int3 padding
+            };
+            std::vector<uint8_t> out;
+            out.reserve(bytes + 16);
+            uint32_t x = seed ? seed : 1;
+            auto next = [&x] { x ^= x << 13; x ^= x >> 17; x ^= x << 5; return x; };
+            while (out.size() < bytes) {
+                for (int b : frags[next() % frags.size()])
+                    out.push_back(b < 0 ? static_cast<uint8_t>(next()) : static_cast<uint8_t>(b));
+            }
+            out.resize(bytes);
+            return out;
+        }
+
+        struct KernelBenchResult {
+            Kernel kernel;
+            const char* name;
+            double gbps;   // best of the repetitions
+            size_t offset; // match offset; identical across kernels when results agree
+        };
+
+        // Plants one concrete instance of the pattern near the end of a synthetic buffer and
+        // times a full sweep with every kernel this CPU supports.
+        // example: for (auto& r : IMH::Scanner::benchmark_kernels()) IMH::Console::Print(r.name, ": ", r.gbps, " GB/s");
+        static std::vector<KernelBenchResult> benchmark_kernels(const std::string& ascii = "48 8B 0D ?? ?? ?? ?? 48 85 C9 74 ?? E8",
+            size_t bytes = size_t(64) << 20, int reps = 5)
+        {
+            std::vector<KernelBenchResult> results;
+            std::vector<uint8_t> pat, mask;
+            MaskedPattern mp{};
+            try { mp = compile_ascii_pattern(ascii, pat, mask); }
+            catch (...) { return results; }
+            if (bytes < mp.len * 2) return results;
+
+            std::vector<uint8_t> buf = make_synthetic_code(bytes);
+            uint8_t* plant = buf.data() + bytes - mp.len - 1;
+            for (size_t j = 0; j < mp.len; ++j)
+                plant[j] = static_cast<uint8_t>((plant[j] & ~mp.mask[j]) | (mp.pat[j] & mp.mask[j]));
+
+            for (Kernel k : { Kernel::Scalar, Kernel::SSE2, Kernel::AVX2, Kernel::AVX512 }) {
+                if (!kernel_supported(k)) continue;
+                double best = 0.0;
+                size_t off = bytes;
+                for (int r = 0; r < (reps > 0 ? reps : 1); ++r) {
+                    const auto t0 = std::chrono::steady_clock::now();
+                    off = find_masked(buf.data(), buf.size(), mp, k);
+                    const auto t1 = std::chrono::steady_clock::now();
+                    const double sec = std::chrono::duration<double>(t1 - t0).count();
+                    const double scanned = static_cast<double>(off == bytes ? bytes : off + mp.len);
+                    if (sec > 0.0) best = (std::max)(best, scanned / sec / 1e9);
+                }
+                results.push_back({ k, kernel_name(k), best, off });
+            }
+            return results;
+        }
+
+        // ----------------------- PE helpers (.text range) -----------------------
+        struct Range { uint8_t* base; size_t size; };
+        static bool get_text_range(HMODULE mod, Range& out) {
+            auto base = reinterpret_cast<uint8_t*>(mod);
+            auto dos = reinterpret_cast<IMAGE_DOS_HEADER*>(base);
+            if (!dos || dos->e_magic != IMAGE_DOS_SIGNATURE) return false;
+            auto nt = reinterpret_cast<IMAGE_NT_HEADERS*>(base + dos->e_lfanew);
+            if (!nt || nt->Signature != IMAGE_NT_SIGNATURE) return false;
+
+            auto sect = IMAGE_FIRST_SECTION(nt);
+            for (WORD i = 0; i < nt->FileHeader.NumberOfSections; ++i) {
+                const IMAGE_SECTION_HEADER& s = sect[i];
+                // section name is not null-terminated; compare up to 8
+                if (std::equal(std::begin(".text"), std::end(".text") - 1, reinterpret_cast<const char*>(s.Name))) {
+                    out.base = base + s.VirtualAddress;
+                    out.size = s.Misc.VirtualSize ? s.Misc.VirtualSize : s.SizeOfRawData;
+                    return true;
+                }
             }
+            // fallback (packed/renamed sections): largest committed executable run in the image,
+            // never the whole SizeOfImage, which can include reserved or no-access pages
+            const uintptr_t img = reinterpret_cast<uintptr_t>(base);
+            const auto regions = Memory::GetLocalRegions(Memory::Readable | Memory::Executable, img, img + nt->OptionalHeader.SizeOfImage);
+            const Memory::Region* best = nullptr;
+            for (const Memory::Region& reg : regions)
+                if (!best || reg.size > best->size) best = &reg;
+            if (!best) return false;
+            out.base = reinterpret_cast<uint8_t*>(best->base);
+            out.size = best->size;
+            return true;
+        }
+
+        // ----------------------- Module enumeration -----------------------
+        // Module names are compared ASCII case-insensitively (no locale lookups per character).
+        static constexpr char ascii_lower(char c) { return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c; }
+        static bool iequals(std::string_view a, std::string_view b) {
+            if (a.size() != b.size()) return false;
+            for (size_t i = 0; i < a.size(); ++i)
+                if (ascii_lower(a[i]) != ascii_lower(b[i])) return false;
+            return true;
+        }
+        static std::string filename_only(const std::string& path) {
+            const char* sep = "\\/";
+            size_t pos = path.find_last_of(sep);
+            return (pos == std::string::npos) ? path : path.substr(pos + 1);
+        }
+
+        // ----------------------- Module registry -----------------------
+        // Loaded modules by file name (base, image size, code range), kept current through the
+        // loader's DLL notifications so a lookup is one hash probe instead of EnumProcessModules
+        // + GetModuleFileNameExA for every module. If ntdll does not export the notification API,
+        // a lookup miss re-enumerates instead. Not capped at any module count.
+        // example: HMODULE mod = IMH::Scanner::ModuleRegistry::instance().find_handle("game.dll");
+        struct ModuleInfo {
+            std::string name;         // file name, lower-case
+            HMODULE handle = nullptr;
+            size_t size = 0;          // SizeOfImage
+            Range text{};             // get_text_range
+        };
+
+        // Case-insensitive, usable with std::string_view keys without building a std::string.
+        struct ModuleNameHash {
+            using is_transparent = void;
+            size_t operator()(std::string_view s) const noexcept {
+                uint64_t h = 0xCBF29CE484222325ull;
+                for (char c : s) { h ^= static_cast<uint8_t>(ascii_lower(c)); h *= 0x100000001B3ull; }
+                return static_cast<size_t>(h);
+            }
+        };
+        struct ModuleNameEq {
+            using is_transparent = void;
+            bool operator()(std::string_view a, std::string_view b) const noexcept { return iequals(a, b); }
+        };
+
+        class ModuleRegistry {
+        public:
+            static ModuleRegistry& instance() {
+                static ModuleRegistry reg;
+                return reg;
+            }
+
+            ModuleRegistry(const ModuleRegistry&) = delete;
+            ModuleRegistry& operator=(const ModuleRegistry&) = delete;
+
+            ~ModuleRegistry() {
+                // The callback lives in this image; it must not outlive it (e.g. FreeLibrary of a DLL using IMH).
+                if (cookie && unregister_fn) unregister_fn(cookie);
+            }
+
+            // Accepts a bare name or a full path, any case. nullptr when not loaded.
+            HMODULE find_handle(std::string_view name) {
+                name = filename_view(name);
+                for (int attempt = 0; attempt < 2; ++attempt) {
+                    {
+                        std::lock_guard<std::mutex> lg(mx);
+                        auto it = by_name.find(name);
+                        if (it != by_name.end()) return list[it->second].handle;
+                        if (cookie) return nullptr; // notifications keep us exact; a miss is a miss
+                    }
+                    if (attempt == 0) refresh();
+                }
+                return nullptr;
+            }
+
+            bool find(std::string_view name, ModuleInfo& out) {
+                if (!find_handle(name)) return false;
+                std::lock_guard<std::mutex> lg(mx);
+                auto it = by_name.find(filename_view(name));
+                if (it == by_name.end()) return false;
+                out = list[it->second];
+                return true;
+            }
+
+            // Code ranges in load order (main module first), the order scan_all_modules uses.
+            std::vector<Range> text_ranges() {
+                std::lock_guard<std::mutex> lg(mx);
+                std::vector<Range> out;
+                out.reserve(list.size());
+                for (const ModuleInfo& m : list) if (m.text.base) out.push_back(m.text);
+                return out;
+            }
+
+            std::vector<ModuleInfo> modules() {
+                std::lock_guard<std::mutex> lg(mx);
+                return list;
+            }
+
+            // Bumped on every load, unload and refresh; lets callers cheaply detect changes.
+            uint64_t generation() const { return gen.load(std::memory_order_acquire); }
+            bool notifications() const { return cookie != nullptr; }
+
+            // Full re-enumeration; the module list is grown until it fits.
+            void refresh() {
+                HANDLE proc = GetCurrentProcess();
+                for (;;) {
+                    const uint64_t start = gen.load(std::memory_order_acquire);
+                    std::vector<HMODULE> mods(256);
+                    DWORD needed = 0;
+                    for (;;) {
+                        const DWORD bytes = static_cast<DWORD>(mods.size() * sizeof(HMODULE));
+                        if (!EnumProcessModules(proc, mods.data(), bytes, &needed)) return;
+                        if (needed <= bytes) break;
+                        mods.resize(needed / sizeof(HMODULE));
+                    }
+                    mods.resize(needed / sizeof(HMODULE));
+
+                    std::vector<ModuleInfo> fresh;
+                    fresh.reserve(mods.size());
+                    for (HMODULE m : mods) {
+                        char path[MAX_PATH] = {};
+                        if (!GetModuleFileNameExA(proc, m, path, MAX_PATH)) continue;
+                        fresh.push_back(make_info(m, filename_only(path)));
+                    }
+
+                    std::lock_guard<std::mutex> lg(mx);
+                    if (gen.load(std::memory_order_relaxed) != start) continue; // a load/unload raced the walk
+                    list = std::move(fresh);
+                    reindex();
+                    gen.fetch_add(1, std::memory_order_release);
+                    return;
+                }
+            }
+
+        private:
+            // LdrRegisterDllNotification types (not in the SDK headers).
+            struct LdrUnicodeString { USHORT Length; USHORT MaximumLength; PWSTR Buffer; };
+            struct LdrNotificationData { ULONG Flags; const LdrUnicodeString* FullDllName; const LdrUnicodeString* BaseDllName; PVOID DllBase; ULONG SizeOfImage; };
+            using LdrNotifyFn = VOID(NTAPI*)(ULONG reason, const LdrNotificationData* data, PVOID context);
+            using LdrRegisterFn = LONG(NTAPI*)(ULONG flags, LdrNotifyFn fn, PVOID context, PVOID* cookie);
+            using LdrUnregisterFn = LONG(NTAPI*)(PVOID cookie);
+            static constexpr ULONG ldr_loaded = 1, ldr_unloaded = 2;
+
+            ModuleRegistry() {
+                // Register before the first walk so nothing loaded in between is missed.
+                if (HMODULE ntdll = GetModuleHandleA("ntdll.dll")) {
+                    auto reg = reinterpret_cast<LdrRegisterFn>(GetProcAddress(ntdll, "LdrRegisterDllNotification"));
+                    unregister_fn = reinterpret_cast<LdrUnregisterFn>(GetProcAddress(ntdll, "LdrUnregisterDllNotification"));
+                    if (reg && unregister_fn && reg(0, &ModuleRegistry::on_dll_notification, this, &cookie) != 0)
+                        cookie = nullptr;
+                }
+                refresh();
+            }
+
+            static std::string_view filename_view(std::string_view path) {
+                const size_t pos = path.find_last_of("\\/");
+                return pos == std::string_view::npos ? path : path.substr(pos + 1);
+            }
+
+            static ModuleInfo make_info(HMODULE mod, std::string name) {
+                ModuleInfo info;
+                for (char& c : name) c = ascii_lower(c);
+                info.name = std::move(name);
+                info.handle = mod;
+                auto dos = reinterpret_cast<IMAGE_DOS_HEADER*>(mod);
+                if (dos && dos->e_magic == IMAGE_DOS_SIGNATURE) {
+                    auto nt = reinterpret_cast<IMAGE_NT_HEADERS*>(reinterpret_cast<uint8_t*>(mod) + dos->e_lfanew);
+                    if (nt->Signature == IMAGE_NT_SIGNATURE) info.size = nt->OptionalHeader.SizeOfImage;
+                }
+                if (!get_text_range(mod, info.text)) info.text = Range{};
+                return info;
+            }
+
+            // Called with the loader lock held: no loader calls in here, only our own mutex.
+            static VOID NTAPI on_dll_notification(ULONG reason, const LdrNotificationData* data, PVOID context) {
+                auto self = static_cast<ModuleRegistry*>(context);
+                if (!self || !data || !data->DllBase) return;
+                const HMODULE mod = static_cast<HMODULE>(data->DllBase);
+                if (reason == ldr_loaded) {
+                    std::string name;
+                    if (const LdrUnicodeString* s = data->BaseDllName; s && s->Buffer && s->Length) {
+                        const int wlen = static_cast<int>(s->Length / sizeof(WCHAR));
+                        const int len = WideCharToMultiByte(CP_ACP, 0, s->Buffer, wlen, nullptr, 0, nullptr, nullptr);
+                        if (len > 0) {
+                            name.resize(static_cast<size_t>(len));
+                            WideCharToMultiByte(CP_ACP, 0, s->Buffer, wlen, &name[0], len, nullptr, nullptr);
+                        }
+                    }
+                    ModuleInfo info = make_info(mod, std::move(name));
+                    std::lock_guard<std::mutex> lg(self->mx);
+                    self->list.push_back(std::move(info));
+                    self->reindex();
+                    self->gen.fetch_add(1, std::memory_order_release);
+                }
+                else if (reason == ldr_unloaded) {
+                    std::lock_guard<std::mutex> lg(self->mx);
+                    self->list.erase(std::remove_if(self->list.begin(), self->list.end(),
+                        [mod](const ModuleInfo& m) { return m.handle == mod; }), self->list.end());
+                    self->reindex();
+                    self->gen.fetch_add(1, std::memory_order_release);
+                }
+            }
+
+            // First module with a given name wins, as with the old EnumProcessModules walk.
+            void reindex() {
+                by_name.clear();
+                for (size_t i = 0; i < list.size(); ++i) by_name.emplace(list[i].name, i);
+            }
+
+            std::vector<ModuleInfo> list; // load order
+            std::unordered_map<std::string, size_t, ModuleNameHash, ModuleNameEq> by_name;
+            std::mutex mx;
+            std::atomic<uint64_t> gen{ 0 };
+            PVOID cookie = nullptr;
+            LdrUnregisterFn unregister_fn = nullptr;
+        };
+
+        // ----------------------- Opt-in tuned plans -----------------------
+        // Scans use the signature's precomputed plan. Tuning costs one extra pass over (a sample
+        // of) the memory, so it is only worth it for a signature scanned many times over the same
+        // code: build the plan once, keep it, and pass it to the scan_range/scan_ranges_parallel
+        // overloads that take a plan. Code can be rewritten (JIT), so rebuild it when that matters;
+        // a stale plan only costs speed, never correctness.
+        // example: const IMH::Scanner::ScanPlan plan = IMH::Scanner::tuned_plan(sig.pattern(), text);
+        //          for (...) addr = IMH::Scanner::scan_range(text, sig, plan);
+        static ScanPlan tuned_plan(const MaskedPattern& mp, const std::vector<Range>& ranges) {
+            ByteHistogram h;
+            for (const Range& r : ranges) {
+                const ByteHistogram rh = build_byte_histogram(r.base, r.size);
+                for (size_t b = 0; b < 256; ++b) h.count[b] += rh.count[b];
+                h.total += rh.total;
+            }
+            return make_plan(mp, h);
+        }
+
+        static ScanPlan tuned_plan(const MaskedPattern& mp, const Range& r) {
+            return make_plan(mp, build_byte_histogram(r.base, r.size));
+        }
+
+        // Default (first/last byte) plan vs histogram-tuned plan on real code, per kernel.
+        struct AnchorBenchResult {
+            std::string pattern;
+            Kernel kernel;
+            const char* name;
+            double default_gbps; // best of the repetitions
+            double tuned_gbps;
+            bool agree;          // both plans returned the same offset
+        };
+
+        // Prologue-heavy signatures whose first/last bytes are among the most common in x86-64.
+        // The corpus defaults to the .text of the main module.
+        // example: for (auto& r : IMH::Scanner::benchmark_anchor_selection())
+        //              IMH::Console::Print(r.pattern, " ", r.name, ": ", r.default_gbps, " -> ", r.tuned_gbps, " GB/s");
+        static std::vector<AnchorBenchResult> benchmark_anchor_selection(Range corpus = {},
+            const std::vector<std::string>& patterns = {
+                "48 89 5C 24 ?? 48 89 74 24 ?? 57 48 83 EC ?? 48 8B",
+                "48 8B C4 48 89 58 ?? 48 89 68 ?? 48 89 70 ?? 48",
+                "40 53 48 83 EC ?? 48 8B D9 E8 ?? ?? ?? ?? 48",
+                "CC CC CC CC 48 89 5C 24 ?? 55 56 57 41 56 41 57 48 8B",
+                "00 00 48 8B 05 ?? ?? ?? ?? 48 85 C0 74 ?? 8B" },
+            int reps = 5)
+        {
+            std::vector<AnchorBenchResult> results;
+            if (!corpus.base && !get_text_range(GetModuleHandleA(NULL), corpus)) return results;
+            if (!corpus.base || !corpus.size) return results;
+            const ByteHistogram h = build_byte_histogram(corpus.base, corpus.size);
+
+            for (const std::string& ascii : patterns) {
+                const Signature sig(ascii);
+                if (!sig.valid()) continue;
+                const ScanPlan tuned = make_plan(sig.pattern(), h);
+                for (Kernel k : { Kernel::Scalar, Kernel::SSE2, Kernel::AVX2, Kernel::AVX512 }) {
+                    if (!kernel_supported(k)) continue;
+                    size_t offs[2] = { corpus.size, corpus.size };
+                    double best[2] = { 0.0, 0.0 };
+                    const ScanPlan* plans[2] = { &sig.scan_plan(), &tuned };
+                    for (int p = 0; p < 2; ++p) {
+                        for (int r = 0; r < (reps > 0 ? reps : 1); ++r) {
+                            const auto t0 = std::chrono::steady_clock::now();
+                            offs[p] = find_masked(corpus.base, corpus.size, sig.pattern(), *plans[p], k);
+                            const auto t1 = std::chrono::steady_clock::now();
+                            const double sec = std::chrono::duration<double>(t1 - t0).count();
+                            const double scanned = static_cast<double>(offs[p] == corpus.size ? corpus.size : offs[p] + sig.size());
+                            if (sec > 0.0) best[p] = (std::max)(best[p], scanned / sec / 1e9);
+                        }
+                    }
+                    results.push_back({ ascii, k, kernel_name(k), best[0], best[1], offs[0] == offs[1] });
+                }
+            }
+            return results;
+        }
+
+        // ----------------------- Core scanning -----------------------
+        // Caller-supplied plan, e.g. from tuned_plan.
+        static uintptr_t scan_range(const Range& r, const Signature& sig, const ScanPlan& plan) {
+            if (!r.base || !sig.valid()) return 0;
+            size_t off = find_masked(r.base, r.size, sig.pattern(), plan);
+            return (off == r.size) ? 0 : (reinterpret_cast<uintptr_t>(r.base) + off);
+        }
+
+        static uintptr_t scan_range(const Range& r, const Signature& sig) {
+            return scan_range(r, sig, sig.scan_plan());
+        }
+
+        template<size_t Len>
+        static uintptr_t scan_range(const Range& r, const StaticSignature<Len>& sig) {
+            if (!r.base) return 0;
+            size_t off = find_masked(r.base, r.size, sig.pattern(), sig.scan_plan());
+            return (off == r.size) ? 0 : (reinterpret_cast<uintptr_t>(r.base) + off);
+        }
+
+        static uintptr_t scan_range(const Range& r, const std::string& ascii) {
+            return scan_range(r, Signature(ascii));
+        }
+
+        static uintptr_t scan_module(HMODULE mod, const Signature& sig) {
+            Range r{};
+            if (!get_text_range(mod, r)) return 0;
+            return scan_range(r, sig);
+        }
+
+        static uintptr_t scan_module(HMODULE mod, const std::string& ascii) {
+            return scan_module(mod, Signature(ascii));
+        }
+
+        static uintptr_t scan_all_modules(const Signature& sig) {
+            if (!sig.valid()) return 0;
+            // Load order: main module first, then the rest
+            for (const Range& r : ModuleRegistry::instance().text_ranges())
+                if (auto addr = scan_range(r, sig)) return addr;
+            return 0;
+        }
+
+        static uintptr_t scan_all_modules(const std::string& ascii) {
+            return scan_all_modules(Signature(ascii));
+        }
+
+        // ----------------------- Find all matches -----------------------
+        // Lazily walks every (possibly overlapping) match of a signature in a range, lowest
+        // address first, without collecting them into a vector. Works with Signature and "..."_sig;
+        // the signature must outlive the FindAll object.
+        // example: for (uintptr_t addr : IMH::Scanner::FindAll(r, sig)) IMH::Console::Print(std::hex, addr);
+        //          size_t n = IMH::Scanner::count_matches(r, sig, 2); // 1 → signature is unique
+        class FindAll {
+        public:
+            template<typename Sig>
+            FindAll(const Range& r, const Sig& sig, size_t max_count = SIZE_MAX)
+                : hay(r.base), n(r.base ? r.size : 0), mp(sig.pattern()), plan(&sig.scan_plan()),
+                  limit(sig.valid() ? max_count : 0) {}
+
+            class iterator {
+            public:
+                using iterator_category = std::input_iterator_tag;
+                using value_type = uintptr_t;
+                using difference_type = ptrdiff_t;
+                using pointer = const uintptr_t*;
+                using reference = uintptr_t;
+
+                iterator() = default;
+                uintptr_t operator*() const { return reinterpret_cast<uintptr_t>(owner->hay) + pos; }
+                iterator& operator++() { advance(pos + 1); return *this; }
+                iterator operator++(int) { iterator tmp = *this; ++*this; return tmp; }
+                bool operator==(const iterator& o) const { return owner == o.owner && pos == o.pos; }
+                bool operator!=(const iterator& o) const { return !(*this == o); }
+
+            private:
+                friend class FindAll;
+                iterator(const FindAll* f, size_t start) : owner(f), pos(f->n) { if (f->limit) advance(start); }
+
+                void advance(size_t from) {
+                    const size_t n = owner->n;
+                    if (seen >= owner->limit || from >= n) { pos = n; return; }
+                    const size_t off = find_masked(owner->hay + from, n - from, owner->mp, *owner->plan);
+                    pos = (off == n - from) ? n : from + off;
+                    if (pos != n) ++seen;
+                }
+
+                const FindAll* owner = nullptr;
+                size_t pos = 0;
+                size_t seen = 0;
+            };
+
+            iterator begin() const { return iterator(this, 0); }
+            iterator end() const { iterator it; it.owner = this; it.pos = n; return it; }
+
+        private:
+            const uint8_t* hay;
+            size_t n;
+            MaskedPattern mp;
+            const ScanPlan* plan;
+            size_t limit;
+        };
+
+        // Calls cb(address) for each match in ascending order until it returns false.
+        // Returns how many matches were reported.
+        template<typename Sig, typename F>
+        static size_t for_each_match(const Range& r, const Sig& sig, F&& cb, size_t max_count = SIZE_MAX) {
+            size_t count = 0;
+            for (uintptr_t addr : FindAll(r, sig, max_count)) {
+                ++count;
+                if (!cb(addr)) break;
+            }
+            return count;
+        }
+
+        // Number of matches, stopping early at max_count (pass 2 to test uniqueness cheaply).
+        template<typename Sig>
+        static size_t count_matches(const Range& r, const Sig& sig, size_t max_count = SIZE_MAX) {
+            FindAll all(r, sig, max_count);
+            size_t count = 0;
+            for (auto it = all.begin(); it != all.end(); ++it) ++count;
+            return count;
+        }
+
+        // ----------------------- Parallel chunked scanning -----------------------
+        // Ranges are cut into chunks of candidate start offsets; each chunk reads len-1 extra
+        // bytes so matches straddling a boundary are still seen. Chunks are numbered in scan order
+        // (ranges in the order given, addresses ascending) and a hit only cancels chunks numbered
+        // after it, so the result is exactly what a sequential scan would return.
+        static constexpr size_t parallel_chunk_size = size_t(1) << 20;
+
+        static uintptr_t scan_ranges_parallel(const std::vector<Range>& ranges, const MaskedPattern& mp,
+            const ScanPlan& plan, size_t chunk_size = parallel_chunk_size)
+        {
+            struct Chunk { const uint8_t* base; size_t size; };
+            std::vector<Chunk> chunks;
+            if (!mp.len || !chunk_size) return 0;
+            for (const Range& r : ranges) {
+                if (!r.base || r.size < mp.len) continue;
+                const size_t starts = r.size - mp.len + 1;
+                for (size_t s = 0; s < starts; s += chunk_size) {
+                    const size_t count = (std::min)(chunk_size, starts - s);
+                    chunks.push_back({ r.base + s, count + mp.len - 1 });
+                }
+            }
+            if (chunks.empty()) return 0;
+
+            std::vector<uintptr_t> hits(chunks.size(), 0);
+            std::atomic<size_t> first_hit{ chunks.size() };
+            Helpers::DefaultPool().ParallelFor(chunks.size(), [&](size_t i) {
+                if (i > first_hit.load(std::memory_order_relaxed)) return; // an earlier chunk already matched
+                const Chunk& c = chunks[i];
+                const size_t off = find_masked(c.base, c.size, mp, plan);
+                if (off == c.size) return;
+                hits[i] = reinterpret_cast<uintptr_t>(c.base) + off;
+                size_t cur = first_hit.load();
+                while (i < cur && !first_hit.compare_exchange_weak(cur, i)) {}
+            });
+            const size_t best = first_hit.load();
+            return best < chunks.size() ? hits[best] : 0;
+        }
+
+        static uintptr_t scan_ranges_parallel(const std::vector<Range>& ranges, const Signature& sig,
+            size_t chunk_size = parallel_chunk_size)
+        {
+            if (!sig.valid()) return 0;
+            return scan_ranges_parallel(ranges, sig.pattern(), sig.scan_plan(), chunk_size);
+        }
+
+        static uintptr_t scan_range_parallel(const Range& r, const Signature& sig) {
+            return scan_ranges_parallel({ r }, sig);
+        }
+
+        static uintptr_t scan_range_parallel(const Range& r, const std::string& ascii) {
+            return scan_range_parallel(r, Signature(ascii));
+        }
+
+        // Same module order as scan_all_modules (main module first), all modules in flight at once.
+        static uintptr_t scan_all_modules_parallel(const Signature& sig) {
+            if (!sig.valid()) return 0;
+            return scan_ranges_parallel(ModuleRegistry::instance().text_ranges(), sig);
+        }
+
+        static uintptr_t scan_all_modules_parallel(const std::string& ascii) {
+            return scan_all_modules_parallel(Signature(ascii));
         }
 
-        std::wstring ReadWideString(uintptr_t address, size_t maxLength = 256) noexcept
-        {
-            if (!Helpers::IsValidAddr(address))
-                return {};
+        // ----------------------- Region lists -----------------------
+        // Scans whatever Memory::GetLocalRegions returned: every committed page that passed the
+        // filter, so packed sections and JIT code outside any module are covered while reserved
+        // or no-access gaps are never touched. Regions are scanned in the order given.
+        // The regions must be local (GetLocalRegions); for another process use scan_backend.
+        // example: auto regions = IMH::Memory::GetLocalRegions(IMH::Memory::Readable | IMH::Memory::Executable);
+        //          uintptr_t addr = IMH::Scanner::scan_regions(regions, sig);
+        static std::vector<Range> regions_to_ranges(const std::vector<Memory::Region>& regions) {
+            std::vector<Range> ranges;
+            ranges.reserve(regions.size());
+            for (const Memory::Region& reg : regions)
+                ranges.push_back({ reinterpret_cast<uint8_t*>(reg.base), reg.size });
+            return ranges;
+        }
 
-            try {
-                const wchar_t* ptr = reinterpret_cast<const wchar_t*>(address);
+        static uintptr_t scan_regions(const std::vector<Memory::Region>& regions, const Signature& sig) {
+            if (!sig.valid()) return 0;
+            for (const Range& r : regions_to_ranges(regions))
+                if (auto addr = scan_range(r, sig)) return addr;
+            return 0;
+        }
 
-                size_t actualLength = 0;
-                for (size_t i = 0; i < maxLength; ++i) {
-                    if (IsBadReadPtr(ptr + i, sizeof(wchar_t)))
-                        break;
+        static uintptr_t scan_regions(const std::vector<Memory::Region>& regions, const std::string& ascii) {
+            return scan_regions(regions, Signature(ascii));
+        }
 
-                    if (ptr[i] == L'\0') {
-                        actualLength = i;
-                        break;
+        // Opt-in: same result as scan_regions, split across Helpers::DefaultPool(). Not from DllMain
+        // or under the loader lock (the pool threads cannot start there).
+        static uintptr_t scan_regions_parallel(const std::vector<Memory::Region>& regions, const Signature& sig) {
+            return scan_ranges_parallel(regions_to_ranges(regions), sig);
+        }
+
+        static uintptr_t scan_regions_parallel(const std::vector<Memory::Region>& regions, const std::string& ascii) {
+            return scan_regions_parallel(regions, Signature(ascii));
+        }
+
+        // Every readable + executable committed region of the process (modules and JIT code).
+        static uintptr_t scan_executable_memory(const Signature& sig) {
+            if (!sig.valid()) return 0;
+            return scan_regions(Memory::GetLocalRegions(Memory::Readable | Memory::Executable), sig);
+        }
+
+        static uintptr_t scan_executable_memory(const std::string& ascii) {
+            return scan_executable_memory(Signature(ascii));
+        }
+
+        // Opt-in pooled variant of scan_executable_memory. Not from DllMain or under the loader lock.
+        static uintptr_t scan_executable_memory_parallel(const Signature& sig) {
+            if (!sig.valid()) return 0;
+            return scan_regions_parallel(Memory::GetLocalRegions(Memory::Readable | Memory::Executable), sig);
+        }
+
+        static uintptr_t scan_executable_memory_parallel(const std::string& ascii) {
+            return scan_executable_memory_parallel(Signature(ascii));
+        }
+
+        // ----------------------- Out-of-process scanning -----------------------
+        // Streams each region of another address space through two chunk buffers: while one
+        // chunk is scanned, the next is already being read by a single reader thread that lives
+        // for the whole call, so the copy and the scan overlap. Chunks overlap by the pattern length - 1 so a match spanning a
+        // boundary is still found. Returns the match address in the target process, 0 if none.
+        // example: IMH::Memory::ProcessBackend game(pid);
+        //          auto regions = IMH::Memory::GetRegions(game, IMH::Memory::Readable | IMH::Memory::Executable);
+        //          uintptr_t addr = IMH::Scanner::scan_backend(game, regions, sig);
+        static uintptr_t scan_backend(Memory::Backend& mem, const std::vector<Memory::Region>& regions,
+                                      const Signature& sig, size_t chunk_bytes = size_t(1) << 20)
+        {
+            if (!sig.valid() || regions.empty()) return 0;
+            const MaskedPattern mp = sig.pattern();
+            const size_t overlap = mp.len - 1;
+            chunk_bytes = (std::max)(chunk_bytes, mp.len);
+
+            struct Piece { uintptr_t base; size_t size; };
+            std::vector<Piece> pieces;
+            for (const Memory::Region& reg : regions) {
+                if (reg.size < mp.len) continue;
+                for (size_t off = 0; off + overlap < reg.size; off += chunk_bytes)
+                    pieces.push_back({ reg.base + off, (std::min)(chunk_bytes + overlap, reg.size - off) });
+            }
+            if (pieces.empty()) return 0;
+
+            // Piece i goes to slot i & 1; the reader fills a slot once the scanner has released it.
+            struct Slot { std::vector<uint8_t> data; bool full = false; bool ok = false; };
+            Slot slots[2];
+            slots[0].data.resize(chunk_bytes + overlap);
+            slots[1].data.resize(chunk_bytes + overlap);
+            std::mutex mx;
+            std::condition_variable cv;
+            bool stop = false;
+
+            std::thread reader([&] {
+                for (size_t i = 0; i < pieces.size(); ++i) {
+                    Slot& s = slots[i & 1];
+                    {
+                        std::unique_lock<std::mutex> lk(mx);
+                        cv.wait(lk, [&] { return stop || !s.full; });
+                        if (stop) return;
+                    }
+                    bool ok = false;
+                    try { ok = mem.Read(pieces[i].base, s.data.data(), pieces[i].size); }
+                    catch (...) {}
+                    {
+                        std::lock_guard<std::mutex> lg(mx);
+                        s.ok = ok;
+                        s.full = true;
                     }
-                    actualLength = i + 1;
+                    cv.notify_all();
                 }
+            });
 
-                return actualLength > 0 ? std::wstring(ptr, actualLength) : std::wstring{};
+            uintptr_t found = 0;
+            for (size_t i = 0; i < pieces.size() && !found; ++i) {
+                Slot& s = slots[i & 1];
+                {
+                    std::unique_lock<std::mutex> lk(mx);
+                    cv.wait(lk, [&] { return s.full; });
+                }
+                if (s.ok) {
+                    const size_t off = find_masked(s.data.data(), pieces[i].size, mp, sig.scan_plan());
+                    if (off != pieces[i].size) found = pieces[i].base + off;
+                }
+                {
+                    std::lock_guard<std::mutex> lg(mx);
+                    s.full = false;
+                }
+                cv.notify_all();
             }
-            catch (...) {
-                return {};
+            {
+                std::lock_guard<std::mutex> lg(mx);
+                stop = true;
             }
+            cv.notify_all();
+            reader.join();
+            return found;
         }
 
-        // String conversion utility
-        std::string WideToString(const std::wstring& wstr) noexcept
-        {
-            if (wstr.empty())
-                return {};
+        static uintptr_t scan_backend(Memory::Backend& mem, const std::vector<Memory::Region>& regions, const std::string& ascii) {
+            return scan_backend(mem, regions, Signature(ascii));
+        }
 
-            try {
-                int size = WideCharToMultiByte(CP_UTF8, 0, wstr.c_str(), -1, nullptr, 0, nullptr, nullptr);
-                if (size <= 0)
-                    return {};
+        // Every readable + executable region behind the backend.
+        static uintptr_t scan_backend(Memory::Backend& mem, const Signature& sig) {
+            return scan_backend(mem, Memory::GetRegions(mem, Memory::Readable | Memory::Executable), sig);
+        }
 
-                std::string result(size - 1, 0);
-                WideCharToMultiByte(CP_UTF8, 0, wstr.c_str(), -1, &result[0], size, nullptr, nullptr);
-                return result;
-            }
-            catch (...) {
-                return {};
+        // ----------------------- Multi-pattern (single pass) -----------------------
+        // Rough frequency class of a byte in x86-64 code (0 = rare .. 3 = everywhere).
+        // Used to pick which known bytes of a pattern make the most selective anchor.
+        static int byte_commonness(uint8_t b) {
+            switch (b) {
+            case 0x00: case 0xFF: case 0xCC: case 0x48: case 0x8B: case 0x89: return 3;
+            case 0x24: case 0x4C: case 0x8D: case 0x0F: case 0x83: case 0xE8: case 0x85: case 0xC0: case 0x01: case 0x44: return 2;
+            case 0x74: case 0x75: case 0xC3: case 0x90: case 0x49: case 0x4D: case 0x41: case 0x20: case 0x10: case 0x08: case 0x40: case 0x33: return 1;
+            default: return 0;
             }
         }
 
-        // Validation result structure
-        struct StringInfo
-        {
-            std::string value;
-            bool isValid;
-            size_t length;
+        struct NamedPattern {
+            std::string name;
+            std::string ascii;
+            std::vector<PostStep> post{}; // applied to the match by patternscan_many
         };
 
-        StringInfo ReadStringInfo(uintptr_t address, size_t maxLength = 256) noexcept
-        {
-            StringInfo info = { {}, false, 0 };
+        // Compiles N signatures into one filter so a range is read once for all of them.
+        // Each pattern contributes one anchor: its least common run of 3 adjacent known bytes,
+        // else 2, else a single known byte. Anchors are spread over 8 buckets of nibble tables
+        // (Teddy-style), so with SSSE3/AVX2 the sweep classifies 16/32 positions per few shuffles.
+        // Surviving positions go through an exact per-length hash filter and only then through
+        // the full masked compare of the patterns anchored there.
+        // Patterns with no known byte at all are scanned on their own with find_masked.
+        class MultiPattern {
+        public:
+            explicit MultiPattern(const std::vector<NamedPattern>& patterns) {
+                entries.resize(patterns.size());
+                for (auto& f : filters) f.assign(65536 / 64, 0);
+                for (size_t e = 0; e < patterns.size(); ++e) {
+                    Entry& en = entries[e];
+                    en.name = patterns[e].name;
+                    if (!parse_ascii_pattern(patterns[e].ascii, en.pat, en.mask)) continue;
+
+                    // Longest known run first (capped at 3), then lowest commonness.
+                    size_t best_at = 0, best_len = 0;
+                    int best_score = 1 << 30;
+                    for (size_t i = 0; i < en.pat.size(); ++i) {
+                        size_t len = 0;
+                        int score = 0;
+                        while (len < 3 && i + len < en.pat.size() && en.mask[i + len] == 0xFF)
+                            score += byte_commonness(en.pat[i + len]), ++len;
+                        if (len > best_len || (len == best_len && len && score < best_score)) {
+                            best_at = i; best_len = len; best_score = score;
+                        }
+                    }
+                    if (!best_len) { unanchored.push_back(static_cast<uint32_t>(e)); continue; }
 
-            std::string str = ReadString(address, maxLength);
-            info.value = str;
-            info.length = str.length();
-            info.isValid = !str.empty();
+                    uint32_t key = 0;
+                    for (size_t k = 0; k < best_len; ++k) key |= static_cast<uint32_t>(en.pat[best_at + k]) << (8 * k);
+                    const uint32_t h = hash_key(key);
+                    filters[best_len - 1][h >> 6] |= uint64_t(1) << (h & 63);
+                    probes[best_len - 1].push_back({ key, static_cast<uint32_t>(e), static_cast<uint32_t>(best_at) });
+                }
 
-            return info;
+                for (auto& list : probes)
+                    std::stable_sort(list.begin(), list.end(), [](const Probe& a, const Probe& b) { return a.key < b.key; });
+                build_nibbles(nullptr, nibbles);
+            }
+
+            size_t size() const { return entries.size(); }
+            const std::string& name(size_t i) const { return entries[i].name; }
+            bool valid(size_t i) const { return !entries[i].pat.empty(); }
+            MaskedPattern view(size_t i) const { return { entries[i].pat.data(), entries[i].mask.data(), entries[i].pat.size() }; }
+
+            // One sweep over r. found[i] (absolute address) is only filled where it is still 0,
+            // so the same vector can be carried across several ranges; returns how many remain.
+            size_t scan(const Range& r, std::vector<uintptr_t>& found) const {
+                found.resize(entries.size(), 0);
+                size_t remaining = 0;
+                for (size_t i = 0; i < entries.size(); ++i) if (valid(i) && !found[i]) ++remaining;
+                if (!remaining || !r.base || !r.size) return remaining;
+
+                const uint8_t* hay = r.base;
+                const size_t n = r.size;
+                const uintptr_t base = reinterpret_cast<uintptr_t>(hay);
+
+                for (uint32_t e : unanchored) {
+                    if (found[e]) continue;
+                    const MaskedPattern mp = view(e);
+                    const size_t off = find_masked(hay, n, mp);
+                    if (off != n) { found[e] = base + off; --remaining; }
+                }
+                if (!remaining) return 0;
+
+                // Called for every position the nibble tables let through; false once all are found.
+                auto check = [&](size_t p) {
+                    uint32_t window = 0;
+                    if (p + 4 <= n) std::memcpy(&window, hay + p, 4);
+                    else for (size_t k = 0; p + k < n; ++k) window |= static_cast<uint32_t>(hay[p + k]) << (8 * k);
+                    for (size_t len = 1; len <= 3 && p + len <= n; ++len) {
+                        if (probes[len - 1].empty()) continue;
+                        const uint32_t key = window & (0xFFFFFFu >> (8 * (3 - len)));
+                        const uint32_t h = hash_key(key);
+                        if (!(filters[len - 1][h >> 6] & (uint64_t(1) << (h & 63)))) continue;
+                        const auto& list = probes[len - 1];
+                        auto it = std::lower_bound(list.begin(), list.end(), key, [](const Probe& a, uint32_t k) { return a.key < k; });
+                        for (; it != list.end() && it->key == key; ++it) {
+                            if (found[it->entry] || p < it->anchor) continue;
+                            const size_t start = p - it->anchor;
+                            const MaskedPattern mp = view(it->entry);
+                            if (start + mp.len > n || !match_at(hay + start, mp)) continue;
+                            found[it->entry] = base + start;
+                            --remaining;
+                        }
+                    }
+                    return remaining != 0;
+                };
+
+                // Found patterns are dropped from the nibble tables so their anchors stop producing candidates.
+                Nibbles nib;
+                build_nibbles(&found, nib);
+                size_t rebuilt_at = remaining;
+                auto refresh = [&]() {
+                    if (remaining == rebuilt_at) return false;
+                    build_nibbles(&found, nib);
+                    rebuilt_at = remaining;
+                    return true;
+                };
+
+                size_t p = 0;
+                const auto& cpu = Helpers::GetCpuFeatures();
+                if (cpu.avx2) p = sweep_avx2(hay, n, nib, check, refresh);
+                else if (cpu.ssse3) p = sweep_ssse3(hay, n, nib, check, refresh);
+                for (; p < n && remaining; ++p) check(p);
+                return remaining;
+            }
+
+        private:
+            // Bucket bits per nibble of each of the (up to) 3 anchor bytes.
+            struct Nibbles { std::array<std::array<uint8_t, 16>, 3> lo{}, hi{}; };
+
+            static uint32_t hash_key(uint32_t key) { return (key * 2654435761u) >> 16; }
+
+            // Neighbouring keys share a bucket so their nibbles overlap and false positives stay low.
+            void build_nibbles(const std::vector<uintptr_t>* found, Nibbles& out) const {
+                out = Nibbles{};
+                size_t total = 0;
+                for (const auto& list : probes)
+                    for (const Probe& pr : list) if (!found || !(*found)[pr.entry]) ++total;
+                size_t rank = 0;
+                for (size_t len = 1; len <= 3; ++len) {
+                    for (const Probe& pr : probes[len - 1]) {
+                        if (found && (*found)[pr.entry]) continue;
+                        const uint8_t bit = static_cast<uint8_t>(1u << (rank++ * 8 / total));
+                        for (size_t k = 0; k < 3; ++k) {
+                            const uint8_t b = static_cast<uint8_t>(pr.key >> (8 * k));
+                            for (int v = 0; v < 16; ++v) {
+                                if (k >= len || (b & 15) == v) out.lo[k][v] |= bit;
+                                if (k >= len || (b >> 4) == v) out.hi[k][v] |= bit;
+                            }
+                        }
+                    }
+                }
+            }
+
+            // Both sweeps return the first position they did not cover. check(p) returns false once
+            // every pattern is found; refresh() returns true when the nibble tables were rebuilt.
+            template<typename F, typename R>
+            IMH_TARGET("ssse3")
+            static size_t sweep_ssse3(const uint8_t* hay, size_t n, const Nibbles& nib, F& check, R& refresh) {
+                __m128i lo[3], hi[3];
+                const __m128i low = _mm_set1_epi8(0x0F);
+                const __m128i zero = _mm_setzero_si128();
+                bool reload = true;
+                size_t p = 0;
+                for (; p + 18 <= n; p += 16) {
+                    if (reload) {
+                        for (int k = 0; k < 3; ++k) {
+                            lo[k] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(nib.lo[k].data()));
+                            hi[k] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(nib.hi[k].data()));
+                        }
+                        reload = false;
+                    }
+                    __m128i c = _mm_set1_epi8(-1);
+                    for (int k = 0; k < 3; ++k) {
+                        const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(hay + p + k));
+                        c = _mm_and_si128(c, _mm_and_si128(_mm_shuffle_epi8(lo[k], _mm_and_si128(v, low)),
+                                                           _mm_shuffle_epi8(hi[k], _mm_and_si128(_mm_srli_epi16(v, 4), low))));
+                    }
+                    uint32_t bits = ~static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(c, zero))) & 0xFFFF;
+                    if (!bits) continue;
+                    while (bits) {
+                        if (!check(p + Helpers::CountTrailingZeros(bits))) return n;
+                        bits &= bits - 1;
+                    }
+                    reload = refresh();
+                }
+                return p;
+            }
+
+            template<typename F, typename R>
+            IMH_TARGET("avx2")
+            static size_t sweep_avx2(const uint8_t* hay, size_t n, const Nibbles& nib, F& check, R& refresh) {
+                __m256i lo[3], hi[3];
+                const __m256i low = _mm256_set1_epi8(0x0F);
+                const __m256i zero = _mm256_setzero_si256();
+                bool reload = true;
+                size_t p = 0;
+                for (; p + 34 <= n; p += 32) {
+                    if (reload) {
+                        for (int k = 0; k < 3; ++k) {
+                            lo[k] = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(nib.lo[k].data())));
+                            hi[k] = _mm256_broadcastsi128_si256(_mm_loadu_si128(reinterpret_cast<const __m128i*>(nib.hi[k].data())));
+                        }
+                        reload = false;
+                    }
+                    __m256i c = _mm256_set1_epi8(-1);
+                    for (int k = 0; k < 3; ++k) {
+                        const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(hay + p + k));
+                        c = _mm256_and_si256(c, _mm256_and_si256(_mm256_shuffle_epi8(lo[k], _mm256_and_si256(v, low)),
+                                                                 _mm256_shuffle_epi8(hi[k], _mm256_and_si256(_mm256_srli_epi16(v, 4), low))));
+                    }
+                    uint32_t bits = ~static_cast<uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(c, zero)));
+                    if (!bits) continue;
+                    while (bits) {
+                        if (!check(p + Helpers::CountTrailingZeros(bits))) return n;
+                        bits &= bits - 1;
+                    }
+                    reload = refresh();
+                }
+                return p;
+            }
+
+            struct Entry { std::string name; std::vector<uint8_t> pat, mask; };
+            struct Probe { uint32_t key; uint32_t entry; uint32_t anchor; };
+            std::vector<Entry> entries;
+            std::array<std::vector<uint64_t>, 3> filters;      // hashed anchor keys, indexed by anchor length - 1
+            std::array<std::vector<Probe>, 3> probes;          // sorted by key
+            Nibbles nibbles;                                   // all patterns; narrowed per scan as they are found
+            std::vector<uint32_t> unanchored;
+        };
+
+        static void scan_module_many(HMODULE mod, const MultiPattern& mp, std::vector<uintptr_t>& found) {
+            Range r{};
+            if (!get_text_range(mod, r)) return;
+            mp.scan(r, found);
         }
-    }
 
-    namespace ByteCodes
-    {
-        // Existing opcodes
-        constexpr BYTE NOP = 0x90;
-        constexpr BYTE RET = 0xC3;
-        constexpr BYTE CALL = 0xE8;
-        constexpr BYTE JMP = 0xE9;
-        constexpr BYTE JE = 0x74;
-        constexpr BYTE JNE = 0x75;
-        constexpr BYTE JG = 0x7F;
-        constexpr BYTE JL = 0x7C;
-        constexpr BYTE JGE = 0x7D;
-        constexpr BYTE JLE = 0x7E;
-        constexpr BYTE PUSH = 0x68;
+        static void scan_all_modules_many(const MultiPattern& mp, std::vector<uintptr_t>& found) {
+            found.assign(mp.size(), 0);
+            // Same order as scan_all_modules: main module first, then the rest
+            for (const Range& r : ModuleRegistry::instance().text_ranges())
+                if (mp.scan(r, found) == 0) return;
+        }
 
-        // Additional common opcodes
-        constexpr BYTE POP = 0x58;          // POP register (base, add register number)
-        constexpr BYTE MOV_REG_IMM32 = 0xB8; // MOV register, immediate32 (base, add register number)
-        constexpr BYTE MOV_EAX_MEM = 0xA1;  // MOV EAX, memory
-        constexpr BYTE MOV_MEM_EAX = 0xA3;  // MOV memory, EAX
-        constexpr BYTE MOV_RM_R = 0x89;     // MOV r/m, register
-        constexpr BYTE MOV_R_RM = 0x8B;     // MOV register, r/m
+        static std::map<std::string, uintptr_t> to_named_results(const MultiPattern& mp, const std::vector<uintptr_t>& found) {
+            std::map<std::string, uintptr_t> out;
+            for (size_t i = 0; i < mp.size(); ++i)
+                out[mp.name(i)] = i < found.size() ? found[i] : 0;
+            return out;
+        }
 
-        // Short jumps (2-byte instructions)
-        constexpr BYTE JMP_SHORT = 0xEB;    // JMP short
-        constexpr BYTE JZ = 0x74;           // JZ (alias for JE)
-        constexpr BYTE JNZ = 0x75;          // JNZ (alias for JNE)
-        constexpr BYTE JS = 0x78;           // Jump if sign
-        constexpr BYTE JNS = 0x79;          // Jump if not sign
-        constexpr BYTE JO = 0x70;           // Jump if overflow
-        constexpr BYTE JNO = 0x71;          // Jump if not overflow
-        constexpr BYTE JB = 0x72;           // Jump if below (unsigned)
-        constexpr BYTE JAE = 0x73;          // Jump if above or equal (unsigned)
-        constexpr BYTE JBE = 0x76;          // Jump if below or equal (unsigned)
-        constexpr BYTE JA = 0x77;           // Jump if above (unsigned)
+        // Runs each pattern's post steps on its match, sharing one page probe across the batch.
+        static void apply_post_steps(const std::vector<NamedPattern>& patterns, std::map<std::string, uintptr_t>& results) {
+            PageProbe probe;
+            for (const NamedPattern& p : patterns) {
+                if (p.post.empty()) continue;
+                auto it = results.find(p.name);
+                if (it != results.end() && it->second) it->second = apply_post_steps(it->second, p.post, probe);
+            }
+        }
 
-        // Arithmetic operations
-        constexpr BYTE ADD_AL_IMM8 = 0x04;  // ADD AL, immediate8
-        constexpr BYTE ADD_EAX_IMM32 = 0x05; // ADD EAX, immediate32
-        constexpr BYTE SUB_AL_IMM8 = 0x2C;  // SUB AL, immediate8
-        constexpr BYTE SUB_EAX_IMM32 = 0x2D; // SUB EAX, immediate32
-        constexpr BYTE CMP_AL_IMM8 = 0x3C;  // CMP AL, immediate8
-        constexpr BYTE CMP_EAX_IMM32 = 0x3D; // CMP EAX, immediate32
+        static HMODULE find_module_by_name(std::string_view name) {
+            if (name.empty() || iequals(name, "exe") || iequals(name, "self")) return GetModuleHandleW(nullptr);
+            if (HMODULE h = ModuleRegistry::instance().find_handle(name)) return h;
+            // Also allow GetModuleHandleA if it's already loaded by that exact name
+            return GetModuleHandleA(filename_only(std::string(name)).c_str());
+        }
 
-        // Stack operations
-        constexpr BYTE PUSH_EAX = 0x50;     // PUSH EAX
-        constexpr BYTE PUSH_ECX = 0x51;     // PUSH ECX
-        constexpr BYTE PUSH_EDX = 0x52;     // PUSH EDX
-        constexpr BYTE PUSH_EBX = 0x53;     // PUSH EBX
-        constexpr BYTE PUSH_ESP = 0x54;     // PUSH ESP
-        constexpr BYTE PUSH_EBP = 0x55;     // PUSH EBP
-        constexpr BYTE PUSH_ESI = 0x56;     // PUSH ESI
-        constexpr BYTE PUSH_EDI = 0x57;     // PUSH EDI
+        // ----------------------- Public API (your two overloads) -----------------------
 
-        constexpr BYTE POP_EAX = 0x58;      // POP EAX
-        constexpr BYTE POP_ECX = 0x59;      // POP ECX
-        constexpr BYTE POP_EDX = 0x5A;      // POP EDX
-        constexpr BYTE POP_EBX = 0x5B;      // POP EBX
-        constexpr BYTE POP_ESP = 0x5C;      // POP ESP
-        constexpr BYTE POP_EBP = 0x5D;      // POP EBP
-        constexpr BYTE POP_ESI = 0x5E;      // POP ESI
-        constexpr BYTE POP_EDI = 0x5F;      // POP EDI
+        // example : void* addr = reinterpret_cast<void*>(IMH::Scanner::patternscan("48 8B ?? ?? ?? ?? ?? 48 85 C0 74 0A"));
+        // example2: void* addr2 = reinterpret_cast<void*>(IMH::Scanner::patternscan("example.dll", "48 8B ?? ?? ?? ?? ?? 48 85 C0 74 0A"));
 
-        // Function operations
-        constexpr BYTE PUSHAD = 0x60;       // Push all general-purpose registers
-        constexpr BYTE POPAD = 0x61;        // Pop all general-purpose registers
-        constexpr BYTE PUSHFD = 0x9C;       // Push flags register
-        constexpr BYTE POPFD = 0x9D;        // Pop flags register
-        constexpr BYTE LEAVE = 0xC9;        // Leave (MOV ESP, EBP; POP EBP)
-        constexpr BYTE RET_IMM16 = 0xC2;    // RET immediate16
-        constexpr BYTE RETN = 0xC3;         // RET near (alias for RET)
-        constexpr BYTE RETF = 0xCB;         // RET far
+        // Full-process scan, module by module on the calling thread (safe from DllMain).
+        inline uintptr_t patternscan(const char* ascii_pattern) {
+            if (!ascii_pattern) return 0;
+            try { return scan_all_modules(ascii_pattern); }
+            catch (...) { return 0; }
+        }
 
-        // Test and logic
-        constexpr BYTE TEST_AL_IMM8 = 0xA8; // TEST AL, immediate8
-        constexpr BYTE TEST_EAX_IMM32 = 0xA9; // TEST EAX, immediate32
-        constexpr BYTE XOR_AL_IMM8 = 0x34;  // XOR AL, immediate8
-        constexpr BYTE XOR_EAX_IMM32 = 0x35; // XOR EAX, immediate32
+        // Opt-in: same result as patternscan, split across Helpers::DefaultPool(). Not from DllMain
+        // or under the loader lock (the pool threads cannot start there).
+        inline uintptr_t patternscan_parallel(const char* ascii_pattern) {
+            if (!ascii_pattern) return 0;
+            try { return scan_all_modules_parallel(ascii_pattern); }
+            catch (...) { return 0; }
+        }
 
-        // Interrupts and special
-        constexpr BYTE INT = 0xCD;          // Interrupt
-        constexpr BYTE INT3 = 0xCC;         // Breakpoint interrupt
-        constexpr BYTE HLT = 0xF4;          // Halt
-        constexpr BYTE CLC = 0xF8;          // Clear carry flag
-        constexpr BYTE STC = 0xF9;          // Set carry flag
-        constexpr BYTE CLI = 0xFA;          // Clear interrupt flag
-        constexpr BYTE STI = 0xFB;          // Set interrupt flag
-        constexpr BYTE CLD = 0xFC;          // Clear direction flag
-        constexpr BYTE STD = 0xFD;          // Set direction flag
+        // All executable memory, including JIT code that belongs to no module, on the calling thread.
+        inline uintptr_t patternscan_executable(const char* ascii_pattern) {
+            if (!ascii_pattern) return 0;
+            try { return scan_executable_memory(ascii_pattern); }
+            catch (...) { return 0; }
+        }
 
-        // Prefix bytes
-        constexpr BYTE LOCK_PREFIX = 0xF0;  // Lock prefix
-        constexpr BYTE REP_PREFIX = 0xF3;   // Repeat prefix
-        constexpr BYTE REPNE_PREFIX = 0xF2; // Repeat while not equal prefix
-        constexpr BYTE CS_OVERRIDE = 0x2E;  // CS segment override
-        constexpr BYTE DS_OVERRIDE = 0x3E;  // DS segment override
-        constexpr BYTE ES_OVERRIDE = 0x26;  // ES segment override
-        constexpr BYTE FS_OVERRIDE = 0x64;  // FS segment override
-        constexpr BYTE GS_OVERRIDE = 0x65;  // GS segment override
-        constexpr BYTE SS_OVERRIDE = 0x36;  // SS segment override
+        // Opt-in: patternscan_executable on Helpers::DefaultPool(). Not from DllMain or under the
+        // loader lock (the pool threads cannot start there).
+        inline uintptr_t patternscan_executable_parallel(const char* ascii_pattern) {
+            if (!ascii_pattern) return 0;
+            try { return scan_executable_memory_parallel(ascii_pattern); }
+            catch (...) { return 0; }
+        }
+
+        inline uintptr_t patternscan(const char* module_name, const char* ascii_pattern) {
+            if (!ascii_pattern) return 0;
+            try {
+                HMODULE mod = find_module_by_name(module_name ? module_name : "");
+                if (!mod) return 0;
+                return scan_module(mod, ascii_pattern);
+            }
+            catch (...) { return 0; }
+        }
+
+        inline uintptr_t patternscan(void* base, size_t size, const char* ascii_pattern) {
+            if (!base || !size || !ascii_pattern) return 0;
+            try {
+                Range r{};
+                r.base = static_cast<uint8_t*>(base);
+                r.size = size;
+                return scan_range(r, ascii_pattern);
+            }
+            catch (...) {
+                return 0;
+            }
+        }
+
+        inline uintptr_t patternscan_parallel(void* base, size_t size, const char* ascii_pattern) {
+            if (!base || !size || !ascii_pattern) return 0;
+            try {
+                Range r{};
+                r.base = static_cast<uint8_t*>(base);
+                r.size = size;
+                return scan_range_parallel(r, ascii_pattern);
+            }
+            catch (...) {
+                return 0;
+            }
+        }
+
+        // Pre-compiled overloads: no parsing or table building per call. The signature's
+        // post steps (if any) are applied to the match.
+        inline uintptr_t patternscan(const Signature& sig) {
+            try { return apply_post_steps(scan_all_modules(sig), sig.post_steps()); }
+            catch (...) { return 0; }
+        }
+
+        inline uintptr_t patternscan_parallel(const Signature& sig) {
+            try { return apply_post_steps(scan_all_modules_parallel(sig), sig.post_steps()); }
+            catch (...) { return 0; }
+        }
+
+        inline uintptr_t patternscan(const char* module_name, const Signature& sig) {
+            try {
+                HMODULE mod = find_module_by_name(module_name ? module_name : "");
+                if (!mod) return 0;
+                return apply_post_steps(scan_module(mod, sig), sig.post_steps());
+            }
+            catch (...) { return 0; }
+        }
 
-		// Basic 
-		constexpr BYTE MOV = 0x89;         // MOV r/m32, r32
-    }
+        inline uintptr_t patternscan(void* base, size_t size, const Signature& sig) {
+            if (!base || !size) return 0;
+            Range r{};
+            r.base = static_cast<uint8_t*>(base);
+            r.size = size;
+            return apply_post_steps(scan_range(r, sig), sig.post_steps());
+        }
 
-    namespace Console
-    {
-        FILE* Initialize(const char* title) noexcept
-        {
-            AllocConsole();
-            SetConsoleTitleA(title);
-            FILE* file;
-            freopen_s(&file, "CONOUT$", "w", stdout);
-            freopen_s(&file, "CONOUT$", "w", stderr);
-            freopen_s(&file, "CONIN$", "r", stdin);
-            return file;
+        // Compile-time literal overloads ("..."_sig).
+        template<size_t Len>
+        inline uintptr_t patternscan(const StaticSignature<Len>& sig) {
+            for (const Range& r : ModuleRegistry::instance().text_ranges())
+                if (auto addr = scan_range(r, sig)) return addr;
+            return 0;
         }
 
-        void Free(FILE* file) noexcept
-        {
-            fclose(file);
-            FreeConsole();
+        template<size_t Len>
+        inline uintptr_t patternscan(const char* module_name, const StaticSignature<Len>& sig) {
+            try {
+                HMODULE mod = find_module_by_name(module_name ? module_name : "");
+                Range r{};
+                if (!mod || !get_text_range(mod, r)) return 0;
+                return scan_range(r, sig);
+            }
+            catch (...) { return 0; }
         }
 
-        void SetTitle(const char* title) noexcept
-        {
-            SetConsoleTitleA(title);
+        template<size_t Len>
+        inline uintptr_t patternscan(void* base, size_t size, const StaticSignature<Len>& sig) {
+            if (!base || !size) return 0;
+            Range r{};
+            r.base = static_cast<uint8_t*>(base);
+            r.size = size;
+            return scan_range(r, sig);
         }
 
-        void SetColor(const WORD color) noexcept
-        {
-            SetConsoleTextAttribute(GetStdHandle(STD_OUTPUT_HANDLE), color);
+        // Batch variants: every pattern is resolved in a single sweep per range.
+        // Unresolved or malformed patterns map to 0.
+        // example: auto addrs = IMH::Scanner::patternscan_many({ { "Update", "48 89 5C 24 ?? 57 48 83 EC 20" }, { "GetHealth", "F3 0F 10 81 ?? ?? ?? ?? C3" } });
+
+        inline std::map<std::string, uintptr_t> patternscan_many(const std::vector<NamedPattern>& patterns) {
+            MultiPattern mp(patterns);
+            std::vector<uintptr_t> found;
+            try { scan_all_modules_many(mp, found); }
+            catch (...) {}
+            auto out = to_named_results(mp, found);
+            apply_post_steps(patterns, out);
+            return out;
         }
 
-        void SetPosition(const short x, const short y) noexcept
-        {
-            SetConsoleCursorPosition(GetStdHandle(STD_OUTPUT_HANDLE), { x, y });
+        inline std::map<std::string, uintptr_t> patternscan_many(const char* module_name, const std::vector<NamedPattern>& patterns) {
+            MultiPattern mp(patterns);
+            std::vector<uintptr_t> found(mp.size(), 0);
+            try {
+                if (HMODULE mod = find_module_by_name(module_name ? module_name : ""))
+                    scan_module_many(mod, mp, found);
+            }
+            catch (...) {}
+            auto out = to_named_results(mp, found);
+            apply_post_steps(patterns, out);
+            return out;
         }
 
-        void Clear() noexcept
-        {
-            system("cls");
+        inline std::map<std::string, uintptr_t> patternscan_many(void* base, size_t size, const std::vector<NamedPattern>& patterns) {
+            MultiPattern mp(patterns);
+            std::vector<uintptr_t> found(mp.size(), 0);
+            if (base && size) {
+                Range r{};
+                r.base = static_cast<uint8_t*>(base);
+                r.size = size;
+                mp.scan(r, found);
+            }
+            auto out = to_named_results(mp, found);
+            apply_post_steps(patterns, out);
+            return out;
         }
 
-        template<typename... T>
-        void Print(T... args)
-        {
-            (std::cout << ... << args) << std::endl;
+        // ----------------------- Persistent resolution cache -----------------------
+        // Remembers resolved RVAs on disk, keyed by module identity, so unchanged builds skip the
+        // scan: a cached RVA is trusted only after one masked compare at that address, and any
+        // miss or mismatch falls back to a normal scan whose result replaces the entry.
+        // Module identity = file name + PE TimeDateStamp + SizeOfImage + a hash of the .text
+        // section header and the first bytes of the range get_text_range returns.
+        // example: IMH::Scanner::SignatureCache cache("sigcache.bin");
+        //          uintptr_t a = cache.resolve("game.dll", "48 8B 05 ?? ?? ?? ?? 48 85 C0");
+        //          cache.save();
+        static uint64_t fnv1a64(const void* data, size_t size, uint64_t h = 0xCBF29CE484222325ull) {
+            const uint8_t* p = static_cast<const uint8_t*>(data);
+            for (size_t i = 0; i < size; ++i) { h ^= p[i]; h *= 0x100000001B3ull; }
+            return h;
         }
-    }
 
-    namespace Matrix
-    {
-        struct Matrix4x4
-        {
-            float m[4][4];
+        struct ModuleIdentity {
+            uint64_t name_hash = 0;  // lower-cased file name
+            uint32_t time_date_stamp = 0;
+            uint32_t size_of_image = 0;
+            uint64_t text_hash = 0;
+            uint64_t key() const {
+                uint64_t h = fnv1a64(&name_hash, sizeof(name_hash));
+                h = fnv1a64(&time_date_stamp, sizeof(time_date_stamp), h);
+                h = fnv1a64(&size_of_image, sizeof(size_of_image), h);
+                return fnv1a64(&text_hash, sizeof(text_hash), h);
+            }
         };
 
-        struct Matrix3x4
-        {
-            float m[3][4];
-        };
+        static bool get_module_identity(HMODULE mod, ModuleIdentity& out) {
+            auto base = reinterpret_cast<uint8_t*>(mod);
+            auto dos = reinterpret_cast<IMAGE_DOS_HEADER*>(base);
+            if (!dos || dos->e_magic != IMAGE_DOS_SIGNATURE) return false;
+            auto nt = reinterpret_cast<IMAGE_NT_HEADERS*>(base + dos->e_lfanew);
+            if (nt->Signature != IMAGE_NT_SIGNATURE) return false;
 
-        struct Matrix3x3
-        {
-            float m[3][3];
-        };
+            char path[MAX_PATH] = {};
+            if (!GetModuleFileNameExA(GetCurrentProcess(), mod, path, MAX_PATH)) return false;
+            std::string file = filename_only(path);
+            for (char& c : file) c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
 
-        struct Matrix2x2
-        {
-            float m[2][2];
-        };
-    }
+            out.name_hash = fnv1a64(file.data(), file.size());
+            out.time_date_stamp = nt->FileHeader.TimeDateStamp;
+            out.size_of_image = nt->OptionalHeader.SizeOfImage;
 
-    namespace Vector
-    {
-        struct Vector2
-        {
-            float x, y;
+            uint64_t h = fnv1a64(nullptr, 0);
+            auto sect = IMAGE_FIRST_SECTION(nt);
+            for (WORD i = 0; i < nt->FileHeader.NumberOfSections; ++i) {
+                if (std::equal(std::begin(".text"), std::end(".text") - 1, reinterpret_cast<const char*>(sect[i].Name))) {
+                    h = fnv1a64(&sect[i], sizeof(IMAGE_SECTION_HEADER), h);
+                    break;
+                }
+            }
+            Range r{};
+            if (get_text_range(mod, r) && r.size)
+                h = fnv1a64(r.base, (std::min)(r.size, size_t(256)), h);
+            out.text_hash = h;
+            return true;
+        }
 
-            Vector2 operator+(const Vector2& other) const noexcept
-            {
-                return { x + other.x, y + other.y };
+        class SignatureCache {
+        public:
+            explicit SignatureCache(std::string file) : path(std::move(file)) { load(); }
+
+            // Cached RVA verified in place, otherwise a full scan of the module's code range.
+            uintptr_t resolve(HMODULE mod, const Signature& sig) {
+                if (!mod || !sig.valid()) return 0;
+                ModuleIdentity id;
+                Range r{};
+                if (!get_module_identity(mod, id) || !get_text_range(mod, r)) return scan_module(mod, sig);
+
+                const uint64_t sig_key = signature_key(sig);
+                const auto base = reinterpret_cast<uintptr_t>(mod);
+                {
+                    std::lock_guard<std::mutex> lg(mx);
+                    auto it = entries.find({ id.key(), sig_key });
+                    if (it != entries.end() && verify(r, base, it->second.rva, sig))
+                        return apply_post_steps(base + it->second.rva, sig.post_steps());
+                }
+
+                const uintptr_t addr = scan_range(r, sig);
+                store(id, sig_key, addr ? static_cast<uint32_t>(addr - base) : 0, addr != 0);
+                return apply_post_steps(addr, sig.post_steps());
             }
 
-            Vector2 operator-(const Vector2& other) const noexcept
-            {
-                return { x - other.x, y - other.y };
+            uintptr_t resolve(const char* module_name, const char* ascii_pattern) {
+                if (!ascii_pattern) return 0;
+                try {
+                    HMODULE mod = find_module_by_name(module_name ? module_name : "");
+                    return mod ? resolve(mod, Signature(ascii_pattern)) : 0;
+                }
+                catch (...) { return 0; }
             }
 
-            Vector2 operator*(const Vector2& other) const noexcept
-            {
-                return { x * other.x, y * other.y };
+            // Batch form: verifies every cached entry, then resolves all misses in one sweep.
+            std::map<std::string, uintptr_t> resolve_many(HMODULE mod, const std::vector<NamedPattern>& patterns) {
+                std::map<std::string, uintptr_t> out;
+                ModuleIdentity id;
+                Range r{};
+                if (!mod || !get_module_identity(mod, id) || !get_text_range(mod, r)) return out;
+                const auto base = reinterpret_cast<uintptr_t>(mod);
+
+                std::vector<NamedPattern> misses;
+                std::vector<uint64_t> miss_keys;
+                for (const NamedPattern& np : patterns) {
+                    Signature sig(np.ascii);
+                    out[np.name] = 0;
+                    if (!sig.valid()) continue;
+                    const uint64_t sig_key = signature_key(sig);
+                    {
+                        std::lock_guard<std::mutex> lg(mx);
+                        auto it = entries.find({ id.key(), sig_key });
+                        if (it != entries.end() && verify(r, base, it->second.rva, sig)) { out[np.name] = base + it->second.rva; continue; }
+                    }
+                    misses.push_back(np);
+                    miss_keys.push_back(sig_key);
+                }
+                if (misses.empty()) { apply_post_steps(patterns, out); return out; }
+
+                MultiPattern mp(misses);
+                std::vector<uintptr_t> found(mp.size(), 0);
+                mp.scan(r, found);
+                for (size_t i = 0; i < misses.size(); ++i) {
+                    out[misses[i].name] = found[i];
+                    store(id, miss_keys[i], found[i] ? static_cast<uint32_t>(found[i] - base) : 0, found[i] != 0);
+                }
+                apply_post_steps(patterns, out);
+                return out;
             }
 
-            Vector2 operator/(const Vector2& other) const noexcept
-            {
-                return { x / other.x, y / other.y };
+            // Writes the cache if anything changed since load (temp file + replace).
+            bool save() {
+                std::lock_guard<std::mutex> lg(mx);
+                if (!dirty) return true;
+                const std::string tmp = path + ".tmp";
+                {
+                    std::ofstream f(tmp, std::ios::binary | std::ios::trunc);
+                    if (!f) return false;
+                    const uint32_t count = static_cast<uint32_t>(entries.size());
+                    f.write(file_magic, sizeof(file_magic));
+                    f.write(reinterpret_cast<const char*>(&file_version), sizeof(file_version));
+                    f.write(reinterpret_cast<const char*>(&count), sizeof(count));
+                    for (const auto& kv : entries) {
+                        const FileEntry fe{ kv.first.first, kv.first.second, kv.second.name_hash, kv.second.rva };
+                        f.write(reinterpret_cast<const char*>(&fe), sizeof(fe));
+                    }
+                    if (!f) return false;
+                }
+                if (!MoveFileExA(tmp.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING)) return false;
+                dirty = false;
+                return true;
             }
 
-            Vector2 WorldToScreen(const Matrix::Matrix4x4& viewMatrix, const int windowWidth, const int windowHeight) const noexcept
-            {
-                Vector2 screen;
-                screen.x = viewMatrix.m[0][0] * x + viewMatrix.m[0][1] * y + viewMatrix.m[0][3];
-                screen.y = viewMatrix.m[1][0] * x + viewMatrix.m[1][1] * y + viewMatrix.m[1][3];
-                const float w = viewMatrix.m[3][0] * x + viewMatrix.m[3][1] * y + viewMatrix.m[3][3];
-                if (w < 0.01f)
-                    return { -1, -1 };
-                screen.x /= w;
-                screen.y /= w;
-                const float width = windowWidth / 2.0f;
-                const float height = windowHeight / 2.0f;
-                screen.x = width + 0.5f * screen.x * width + 0.5f;
-                screen.y = height - 0.5f * screen.y * height + 0.5f;
-                return screen;
+            void clear() {
+                std::lock_guard<std::mutex> lg(mx);
+                dirty = dirty || !entries.empty();
+                entries.clear();
             }
 
-            Vector2 Transform(const Matrix::Matrix2x2& mat) const noexcept
-            {
-                return {
-                    mat.m[0][0] * x + mat.m[0][1] * y,
-                    mat.m[1][0] * x + mat.m[1][1] * y
-                };
+            size_t size() const { std::lock_guard<std::mutex> lg(mx); return entries.size(); }
+
+        private:
+            struct Value { uint64_t name_hash; uint32_t rva; };
+#pragma pack(push, 1)
+            struct FileEntry { uint64_t module_key; uint64_t sig_key; uint64_t name_hash; uint32_t rva; };
+#pragma pack(pop)
+            static constexpr char file_magic[8] = { 'I', 'M', 'H', 'S', 'I', 'G', 'C', '1' };
+            static constexpr uint32_t file_version = 1;
+
+            // Hash of the compiled bytes + masks, so spacing/case differences share an entry.
+            static uint64_t signature_key(const Signature& sig) {
+                const MaskedPattern mp = sig.pattern();
+                return fnv1a64(mp.mask, mp.len, fnv1a64(mp.pat, mp.len));
+            }
+
+            static bool verify(const Range& text, uintptr_t base, uint32_t rva, const Signature& sig) {
+                const uintptr_t addr = base + rva;
+                const uintptr_t lo = reinterpret_cast<uintptr_t>(text.base);
+                if (addr < lo || addr + sig.size() > lo + text.size) return false;
+                return sig.matches(reinterpret_cast<const uint8_t*>(addr));
+            }
+
+            void store(const ModuleIdentity& id, uint64_t sig_key, uint32_t rva, bool found) {
+                std::lock_guard<std::mutex> lg(mx);
+                // Entries of an older build of the same module can never verify again.
+                for (auto it = entries.begin(); it != entries.end();) {
+                    if (it->second.name_hash == id.name_hash && it->first.first != id.key()) { it = entries.erase(it); dirty = true; }
+                    else ++it;
+                }
+                const std::pair<uint64_t, uint64_t> key{ id.key(), sig_key };
+                if (!found) { dirty = entries.erase(key) > 0 || dirty; return; }
+                entries[key] = Value{ id.name_hash, rva };
+                dirty = true;
+            }
+
+            void load() {
+                std::ifstream f(path, std::ios::binary);
+                if (!f) return;
+                char magic[8] = {};
+                uint32_t version = 0, count = 0;
+                f.read(magic, sizeof(magic));
+                f.read(reinterpret_cast<char*>(&version), sizeof(version));
+                f.read(reinterpret_cast<char*>(&count), sizeof(count));
+                if (!f || std::memcmp(magic, file_magic, sizeof(magic)) != 0 || version != file_version) return;
+                for (uint32_t i = 0; i < count; ++i) {
+                    FileEntry fe{};
+                    if (!f.read(reinterpret_cast<char*>(&fe), sizeof(fe))) break;
+                    entries[{ fe.module_key, fe.sig_key }] = Value{ fe.name_hash, fe.rva };
+                }
             }
+
+            std::string path;
+            std::map<std::pair<uint64_t, uint64_t>, Value> entries; // (module key, signature key) → RVA
+            mutable std::mutex mx;
+            bool dirty = false;
         };
 
-        struct Vector3
-        {
-            float x, y, z;
+        // ----------------------- Mapped files -----------------------
+        // Read-only view of a whole file, unmapped on destruction. Move-only.
+        class MappedFile {
+        public:
+            MappedFile() = default;
+            explicit MappedFile(const std::string& path) { open(path); }
+            ~MappedFile() { close(); }
+            MappedFile(const MappedFile&) = delete;
+            MappedFile& operator=(const MappedFile&) = delete;
+            MappedFile(MappedFile&& o) noexcept { *this = std::move(o); }
+            MappedFile& operator=(MappedFile&& o) noexcept {
+                if (this != &o) {
+                    close();
+                    file = o.file; mapping = o.mapping; view = o.view; len = o.len;
+                    o.file = INVALID_HANDLE_VALUE; o.mapping = nullptr; o.view = nullptr; o.len = 0;
+                }
+                return *this;
+            }
 
-            Vector3 operator+(const Vector3& other) const noexcept
-            {
-                return { x + other.x, y + other.y, z + other.z };
+            bool open(const std::string& path) {
+                close();
+                file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+                if (file == INVALID_HANDLE_VALUE) return false;
+                LARGE_INTEGER sz{};
+                if (!GetFileSizeEx(file, &sz) || sz.QuadPart <= 0) { close(); return false; }
+                mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+                if (!mapping) { close(); return false; }
+                view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+                if (!view) { close(); return false; }
+                len = static_cast<size_t>(sz.QuadPart);
+                return true;
             }
 
-            Vector3 operator-(const Vector3& other) const noexcept
-            {
-                return { x - other.x, y - other.y, z - other.z };
+            void close() {
+                if (view) UnmapViewOfFile(view);
+                if (mapping) CloseHandle(mapping);
+                if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+                view = nullptr; mapping = nullptr; file = INVALID_HANDLE_VALUE; len = 0;
             }
 
-            Vector3 operator*(const Vector3& other) const noexcept
-            {
-                return { x * other.x, y * other.y, z * other.z };
+            bool valid() const { return view != nullptr; }
+            const uint8_t* data() const { return static_cast<const uint8_t*>(view); }
+            size_t size() const { return len; }
+
+        private:
+            HANDLE file = INVALID_HANDLE_VALUE;
+            HANDLE mapping = nullptr;
+            LPVOID view = nullptr;
+            size_t len = 0;
+        };
+
+        // ----------------------- Suffix-array index -----------------------
+        // Built once over a Range (4 bytes per byte scanned, ~14 while building); afterwards a
+        // query walks the sorted suffixes along the pattern instead of sweeping the whole range.
+        // Wildcard and nibble bytes branch over the distinct bytes present at that depth; once a
+        // branch is down to a few suffixes they are verified directly. The array can be saved
+        // and mapped back later; load() checks it still belongs to the same bytes.
+        // example: IMH::Scanner::SuffixIndex idx(r);
+        //          size_t hits = idx.count(sig, 2);                 // 1 → unique
+        //          std::string s = IMH::Scanner::make_unique_signature(idx, addr);
+        class SuffixIndex {
+        public:
+            SuffixIndex() = default;
+            explicit SuffixIndex(const Range& r) { build(r); }
+            SuffixIndex(const SuffixIndex&) = delete;
+            SuffixIndex& operator=(const SuffixIndex&) = delete;
+            SuffixIndex(SuffixIndex&&) = default;
+            SuffixIndex& operator=(SuffixIndex&&) = default;
+
+            bool valid() const { return sa != nullptr; }
+            const uint8_t* data() const { return base; }
+            size_t size() const { return n; }
+
+            // Number of matches, stopping at max_count (matches are not visited in address order).
+            size_t count(const MaskedPattern& mp, size_t max_count = SIZE_MAX) const {
+                size_t found = 0;
+                search(mp, [&](size_t) { return ++found < max_count; });
+                return found;
             }
 
-            Vector3 operator/(const Vector3& other) const noexcept
-            {
-                return { x / other.x, y / other.y, z / other.z };
+            // All matches in ascending address order, at most max_count (the lowest ones).
+            size_t find_all(const MaskedPattern& mp, std::vector<uintptr_t>& out, size_t max_count = SIZE_MAX) const {
+                std::vector<size_t> pos;
+                search(mp, [&](size_t p) { pos.push_back(p); return true; });
+                std::sort(pos.begin(), pos.end());
+                if (pos.size() > max_count) pos.resize(max_count);
+                for (size_t p : pos) out.push_back(reinterpret_cast<uintptr_t>(base) + p);
+                return pos.size();
             }
 
-            bool operator==(const Vector3& other) const noexcept
-            {
-                if (x == other.x && y == other.y && z == other.z)
-                    return true;
-                else
-                    return false;
+            // Lowest match, or 0.
+            uintptr_t find(const MaskedPattern& mp) const {
+                size_t best = SIZE_MAX;
+                search(mp, [&](size_t p) { best = (std::min)(best, p); return true; });
+                return best == SIZE_MAX ? 0 : reinterpret_cast<uintptr_t>(base) + best;
             }
 
-            Vector3 WorldToScreen(const Matrix::Matrix4x4& viewMatrix, int windowWidth, int windowHeight) const noexcept
-            {
-                Vector3 clip;
-                clip.x = viewMatrix.m[0][0] * x + viewMatrix.m[0][1] * y + viewMatrix.m[0][2] * z + viewMatrix.m[0][3];
-                clip.y = viewMatrix.m[1][0] * x + viewMatrix.m[1][1] * y + viewMatrix.m[1][2] * z + viewMatrix.m[1][3];
-                clip.z = viewMatrix.m[2][0] * x + viewMatrix.m[2][1] * y + viewMatrix.m[2][2] * z + viewMatrix.m[2][3];
-                float w = viewMatrix.m[3][0] * x + viewMatrix.m[3][1] * y + viewMatrix.m[3][2] * z + viewMatrix.m[3][3];
+            template<typename Sig> size_t count(const Sig& sig, size_t max_count = SIZE_MAX) const {
+                return sig.valid() ? count(sig.pattern(), max_count) : 0;
+            }
+            template<typename Sig> size_t find_all(const Sig& sig, std::vector<uintptr_t>& out, size_t max_count = SIZE_MAX) const {
+                return sig.valid() ? find_all(sig.pattern(), out, max_count) : 0;
+            }
+            template<typename Sig> uintptr_t find(const Sig& sig) const {
+                return sig.valid() ? find(sig.pattern()) : 0;
+            }
 
-                if (w < 0.001f)
-                    return { -1, -1, 0 };
+            bool save(const std::string& path) const {
+                if (!valid()) return false;
+                std::ofstream f(path, std::ios::binary | std::ios::trunc);
+                if (!f) return false;
+                const FileHeader h = make_header();
+                f.write(reinterpret_cast<const char*>(&h), sizeof(h));
+                f.write(reinterpret_cast<const char*>(sa), static_cast<std::streamsize>(n * sizeof(uint32_t)));
+                return static_cast<bool>(f);
+            }
 
-                clip.x /= w;
-                clip.y /= w;
-                clip.z /= w;
+            // Maps a saved index for the same bytes; invalid index if the file or the range changed.
+            static SuffixIndex load(const std::string& path, const Range& r) {
+                SuffixIndex idx;
+                MappedFile file(path);
+                if (!file.valid() || !r.base || file.size() < sizeof(FileHeader)) return idx;
+                FileHeader h{};
+                std::memcpy(&h, file.data(), sizeof(h));
+                idx.base = r.base;
+                idx.n = r.size;
+                const FileHeader want = idx.make_header();
+                if (std::memcmp(&h, &want, sizeof(h)) != 0 || file.size() != sizeof(FileHeader) + r.size * sizeof(uint32_t)) {
+                    idx.base = nullptr; idx.n = 0;
+                    return idx;
+                }
+                idx.sa = reinterpret_cast<const uint32_t*>(file.data() + sizeof(FileHeader));
+                idx.mapped = std::move(file);
+                return idx;
+            }
 
-                Vector3 screen;
-                screen.x = (clip.x * 0.5f + 0.5f) * windowWidth;
-                screen.y = (1.0f - (clip.y * 0.5f + 0.5f)) * windowHeight;
-                screen.z = clip.z;
+        private:
+            struct FileHeader {
+                char magic[8];
+                uint32_t version;
+                uint32_t reserved;
+                uint64_t size;
+                uint64_t data_hash; // sampled, enough to reject an index for another build
+            };
+            static constexpr size_t verify_below = 32; // suffixes left in a branch before direct verification
+
+            FileHeader make_header() const {
+                FileHeader h{ { 'I', 'M', 'H', 'S', 'F', 'X', '1', '\0' }, 1, 0, n, 0 };
+                uint64_t hash = fnv1a64(&h.size, sizeof(h.size));
+                const size_t blocks = 64, block = 256;
+                if (n <= blocks * block) hash = fnv1a64(base, n, hash);
+                else for (size_t k = 0; k < blocks; ++k) hash = fnv1a64(base + (n - block) / (blocks - 1) * k, block, hash);
+                h.data_hash = hash;
+                return h;
+            }
 
-                return screen;
+            // SA-IS (induced sorting), linear time; s[i] in [0, upper]. Recurses on the reduced
+            // string of LMS substrings. A proper prefix sorts before the longer suffix.
+            template<typename T>
+            static std::vector<int32_t> sa_is(const T* s, int32_t n, int32_t upper) {
+                if (n == 0) return {};
+                if (n == 1) return { 0 };
+                if (n == 2) return s[0] < s[1] ? std::vector<int32_t>{ 0, 1 } : std::vector<int32_t>{ 1, 0 };
+
+                std::vector<int32_t> sa(n);
+                std::vector<bool> ls(n); // true = S-type
+                for (int32_t i = n - 2; i >= 0; --i)
+                    ls[i] = (s[i] == s[i + 1]) ? ls[i + 1] : (s[i] < s[i + 1]);
+
+                std::vector<int32_t> sum_l(upper + 1), sum_s(upper + 1);
+                for (int32_t i = 0; i < n; ++i) {
+                    if (!ls[i]) ++sum_s[s[i]];
+                    else ++sum_l[s[i] + 1];
+                }
+                for (int32_t i = 0; i <= upper; ++i) {
+                    sum_s[i] += sum_l[i];
+                    if (i < upper) sum_l[i + 1] += sum_s[i];
+                }
+
+                std::vector<int32_t> buf(upper + 1);
+                auto induce = [&](const std::vector<int32_t>& lms) {
+                    std::fill(sa.begin(), sa.end(), -1);
+                    std::copy(sum_s.begin(), sum_s.end(), buf.begin());
+                    for (int32_t d : lms) if (d != n) sa[buf[s[d]]++] = d;
+                    std::copy(sum_l.begin(), sum_l.end(), buf.begin());
+                    sa[buf[s[n - 1]]++] = n - 1;
+                    for (int32_t i = 0; i < n; ++i) {
+                        const int32_t v = sa[i];
+                        if (v >= 1 && !ls[v - 1]) sa[buf[s[v - 1]]++] = v - 1;
+                    }
+                    std::copy(sum_l.begin(), sum_l.end(), buf.begin());
+                    for (int32_t i = n - 1; i >= 0; --i) {
+                        const int32_t v = sa[i];
+                        if (v >= 1 && ls[v - 1]) sa[--buf[s[v - 1] + 1]] = v - 1;
+                    }
+                };
+
+                std::vector<int32_t> lms_map(n + 1, -1), lms;
+                int32_t m = 0;
+                for (int32_t i = 1; i < n; ++i) if (!ls[i - 1] && ls[i]) lms_map[i] = m++;
+                lms.reserve(m);
+                for (int32_t i = 1; i < n; ++i) if (!ls[i - 1] && ls[i]) lms.push_back(i);
+                induce(lms);
+
+                if (m) {
+                    std::vector<int32_t> sorted_lms;
+                    sorted_lms.reserve(m);
+                    for (int32_t v : sa) if (lms_map[v] != -1) sorted_lms.push_back(v);
+                    std::vector<int32_t> rec_s(m);
+                    int32_t rec_upper = 0;
+                    rec_s[lms_map[sorted_lms[0]]] = 0;
+                    for (int32_t i = 1; i < m; ++i) {
+                        int32_t l = sorted_lms[i - 1], r = sorted_lms[i];
+                        const int32_t end_l = (lms_map[l] + 1 < m) ? lms[lms_map[l] + 1] : n;
+                        const int32_t end_r = (lms_map[r] + 1 < m) ? lms[lms_map[r] + 1] : n;
+                        bool same = true;
+                        if (end_l - l != end_r - r) same = false;
+                        else {
+                            while (l < end_l && s[l] == s[r]) { ++l; ++r; }
+                            if (l == n || s[l] != s[r]) same = false;
+                        }
+                        if (!same) ++rec_upper;
+                        rec_s[lms_map[sorted_lms[i]]] = rec_upper;
+                    }
+                    const std::vector<int32_t> rec_sa = sa_is(rec_s.data(), m, rec_upper);
+                    for (int32_t i = 0; i < m; ++i) sorted_lms[i] = lms[rec_sa[i]];
+                    induce(sorted_lms);
+                }
+                return sa;
             }
 
-            Vector3 WorldToScreen(const Matrix::Matrix3x4& viewMatrix, int windowWidth, int windowHeight) const noexcept
-            {
-                float clipX = viewMatrix.m[0][0] * x + viewMatrix.m[0][1] * y + viewMatrix.m[0][2] * z + viewMatrix.m[0][3];
-                float clipY = viewMatrix.m[1][0] * x + viewMatrix.m[1][1] * y + viewMatrix.m[1][2] * z + viewMatrix.m[1][3];
-                float clipZ = viewMatrix.m[2][0] * x + viewMatrix.m[2][1] * y + viewMatrix.m[2][2] * z + viewMatrix.m[2][3];
-                float clipW = viewMatrix.m[3][0] * x + viewMatrix.m[3][1] * y + viewMatrix.m[3][2] * z + viewMatrix.m[3][3];
+            void build(const Range& r) {
+                if (!r.base || !r.size || r.size >= static_cast<size_t>(INT32_MAX)) return;
+                base = r.base;
+                n = r.size;
+                const std::vector<int32_t> order = sa_is(base, static_cast<int32_t>(n), 255);
+                owned.assign(order.begin(), order.end());
+                sa = owned.data();
+            }
 
-                if (clipW < 0.001f)
-                    return { -1, -1, 0 };
+            // Byte at depth d of suffix p; -1 past the end (sorts before every byte).
+            int byte_at(uint32_t p, size_t d) const { return p + d < n ? base[p + d] : -1; }
 
-                clipX /= clipW;
-                clipY /= clipW;
-                clipZ /= clipW;
+            // First index in [lo, hi) whose byte at depth d is >= b (or > b when upper).
+            size_t bound(size_t lo, size_t hi, size_t d, int b, bool upper) const {
+                while (lo < hi) {
+                    const size_t mid = lo + (hi - lo) / 2;
+                    const int c = byte_at(sa[mid], d);
+                    if (upper ? c <= b : c < b) lo = mid + 1; else hi = mid;
+                }
+                return lo;
+            }
 
-                Vector3 screen;
-                screen.x = (clipX * 0.5f + 0.5f) * windowWidth;
-                screen.y = (1.0f - (clipY * 0.5f + 0.5f)) * windowHeight;
-                screen.z = clipZ;
+            // Calls emit(position) per match until it returns false. Leading wildcards are peeled
+            // off so the walk starts at the first constrained byte, then added back when verifying.
+            template<typename F>
+            void search(const MaskedPattern& mp, F&& emit) const {
+                if (!valid() || !mp.len || mp.len > n) return;
+                size_t lead = 0;
+                while (lead < mp.len && mp.mask[lead] == 0) ++lead;
+                if (lead == mp.len) { // all wildcards
+                    for (size_t p = 0; p + mp.len <= n; ++p) if (!emit(p)) return;
+                    return;
+                }
+                size_t end = mp.len;
+                while (end > lead && mp.mask[end - 1] == 0) --end;
+                bool go = true;
+                walk(mp, lead, end, 0, n, 0, emit, go);
+            }
 
-                return screen;
+            template<typename F>
+            void walk(const MaskedPattern& mp, size_t lead, size_t end, size_t lo, size_t hi, size_t depth, F& emit, bool& go) const {
+                if (!go || lo >= hi) return;
+                const size_t core = end - lead;
+                if (depth == core || hi - lo <= verify_below) {
+                    for (size_t j = lo; j < hi && go; ++j) {
+                        const size_t p = sa[j];
+                        if (p < lead || p - lead + mp.len > n) continue;
+                        // a fully walked branch already matched every constrained byte
+                        if (depth < core && !match_at(base + p - lead, mp)) continue;
+                        go = emit(p - lead);
+                    }
+                    return;
+                }
+                const uint8_t m = mp.mask[lead + depth], v = mp.pat[lead + depth] & m;
+                if (m == 0xFF) {
+                    const size_t a = bound(lo, hi, depth, v, false), b = bound(a, hi, depth, v, true);
+                    walk(mp, lead, end, a, b, depth + 1, emit, go);
+                    return;
+                }
+                // Wildcard / nibble: visit each distinct byte present at this depth.
+                for (size_t j = lo; j < hi && go; ) {
+                    const int c = byte_at(sa[j], depth);
+                    const size_t next = bound(j, hi, depth, c, true);
+                    if (c >= 0 && (static_cast<uint8_t>(c) & m) == v) walk(mp, lead, end, j, next, depth + 1, emit, go);
+                    j = next;
+                }
             }
 
-            Vector3 Transform(const Matrix::Matrix3x3& mat) const noexcept
-            {
-                return {
-                    mat.m[0][0] * x + mat.m[0][1] * y + mat.m[0][2] * z,
-                    mat.m[1][0] * x + mat.m[1][1] * y + mat.m[1][2] * z,
-                    mat.m[2][0] * x + mat.m[2][1] * y + mat.m[2][2] * z
-                };
+            const uint8_t* base = nullptr;
+            size_t n = 0;
+            const uint32_t* sa = nullptr;   // points into owned or mapped
+            std::vector<uint32_t> owned;
+            MappedFile mapped;
+        };
+
+        // Operand bytes that move between builds even when the code itself does not: rel32 of
+        // CALL/JMP (ByteCodes::CALL/JMP) and 0F 8x jcc, and disp32 of RIP-relative ModRM operands
+        // (mod=00, rm=101) behind an optional REX prefix. Heuristic: no length decoding, so an
+        // extra wildcard can appear, which only makes a signature longer, never wrong.
+        static void wildcard_volatile_operands(const uint8_t* p, size_t len, std::vector<uint8_t>& mask) {
+            auto wild = [&](size_t from, size_t count) { for (size_t i = from; i < from + count && i < len; ++i) mask[i] = 0x00; };
+            for (size_t i = 0; i < len; ) {
+                if (p[i] == ByteCodes::CALL || p[i] == ByteCodes::JMP) { wild(i + 1, 4); i += 5; continue; }
+                if (p[i] == 0x0F && i + 1 < len && (p[i + 1] & 0xF0) == 0x80) { wild(i + 2, 4); i += 6; continue; }
+                const size_t op = (p[i] & 0xF0) == 0x40 ? i + 1 : i; // REX
+                if (op + 1 < len) {
+                    const uint8_t o = p[op], modrm = p[op + 1];
+                    const bool modrm_op = o == 0x8B || o == 0x8D || o == 0x89 || o == 0x3B || o == 0x39 ||
+                                          o == 0x03 || o == 0x2B || o == 0x33 || o == 0x85 || o == 0x87;
+                    if (modrm_op && (modrm & 0xC7) == 0x05) { wild(op + 2, 4); i = op + 6; continue; }
+                }
+                ++i;
+            }
+        }
+
+        // Shortest signature starting at addr that matches exactly once in the indexed range,
+        // with volatile operands wildcarded. Empty if none within max_len bytes.
+        static std::string make_unique_signature(const SuffixIndex& idx, uintptr_t addr, size_t max_len = 64) {
+            const uintptr_t lo = reinterpret_cast<uintptr_t>(idx.data());
+            if (!idx.valid() || addr < lo || addr >= lo + idx.size()) return {};
+            const uint8_t* p = reinterpret_cast<const uint8_t*>(addr);
+            const size_t avail = (std::min)(max_len, static_cast<size_t>(lo + idx.size() - addr));
+
+            std::vector<uint8_t> mask(avail, 0xFF);
+            wildcard_volatile_operands(p, avail, mask);
+            auto unique_at = [&](size_t len) { return idx.count(MaskedPattern{ p, mask.data(), len }, 2) == 1; };
+            if (!avail || !unique_at(avail)) return {};
+
+            // Matches of a longer prefix are a subset of a shorter one's, so uniqueness is monotonic.
+            size_t a = 1, b = avail;
+            while (a < b) {
+                const size_t mid = a + (b - a) / 2;
+                if (unique_at(mid)) b = mid; else a = mid + 1;
+            }
+
+            std::string out;
+            char hex[4];
+            for (size_t i = 0; i < a; ++i) {
+                if (i) out += ' ';
+                if (mask[i] == 0xFF) { std::snprintf(hex, sizeof(hex), "%02X", p[i]); out += hex; }
+                else out += "??";
             }
+            return out;
+        }
+
+        // ----------------------- Offline image files -----------------------
+        // Scans a PE (32/64) or ELF64 image straight from disk: the file is mapped read-only,
+        // section headers are parsed from the file and matches in the raw section bytes are
+        // translated back to RVAs. No process, no loader, no copies. Headers are bounds-checked
+        // against the file size, so truncated or hostile files just come back invalid.
+        // example: IMH::Scanner::ImageFile img("builds/1.2.3/game.dll");
+        //          uint64_t rva = img.find_rva(IMH::Scanner::Signature("48 8B 05 ?? ?? ?? ?? 48 85 C0"));
+        struct ImageSection {
+            std::string name;
+            uint64_t rva = 0;           // relative to the image base
+            uint64_t virtual_size = 0;
+            uint64_t file_offset = 0;
+            uint64_t file_size = 0;     // bytes actually present in the file
+            bool executable = false;
         };
 
-        struct Vector4
-        {
-            float x, y, z, w;
+        class ImageFile {
+        public:
+            enum class Format { Unknown, PE32, PE64, ELF64 };
 
-            Vector4 operator+(const Vector4& other) const noexcept
-            {
-                return { x + other.x, y + other.y, z + other.z, w + other.w };
+            explicit ImageFile(const std::string& path) {
+                if (!file.open(path)) { err = "Cannot map " + path; return; }
+                if (!parse_pe() && !parse_elf()) { if (err.empty()) err = "Not a PE or ELF64 image"; sections_.clear(); fmt = Format::Unknown; }
             }
 
-            Vector4 operator-(const Vector4& other) const noexcept
-            {
-                return { x - other.x, y - other.y, z - other.z, w - other.w };
+            bool valid() const { return fmt != Format::Unknown; }
+            const std::string& error() const { return err; }
+            Format format() const { return fmt; }
+            uint64_t image_base() const { return base_va; }
+            const std::vector<ImageSection>& sections() const { return sections_; }
+            const uint8_t* data() const { return file.data(); }
+            size_t size() const { return file.size(); }
+
+            // Raw bytes of every executable section, in header order (pointing into the mapping).
+            std::vector<Range> code_ranges() const {
+                std::vector<Range> out;
+                for (const ImageSection& s : sections_)
+                    if (s.executable && s.file_size) out.push_back({ const_cast<uint8_t*>(file.data() + s.file_offset), static_cast<size_t>(s.file_size) });
+                return out;
             }
 
-            Vector4 operator*(const Vector4& other) const noexcept
-            {
-                return { x * other.x, y * other.y, z * other.z, w * other.w };
+            // UINT64_MAX when the offset/RVA is not backed by a section's file bytes.
+            uint64_t offset_to_rva(uint64_t off) const {
+                for (const ImageSection& s : sections_)
+                    if (off >= s.file_offset && off < s.file_offset + s.file_size) return s.rva + (off - s.file_offset);
+                return UINT64_MAX;
+            }
+            uint64_t rva_to_offset(uint64_t rva) const {
+                for (const ImageSection& s : sections_)
+                    if (rva >= s.rva && rva < s.rva + s.file_size) return s.file_offset + (rva - s.rva);
+                return UINT64_MAX;
             }
 
-            Vector4 operator/(const Vector4& other) const noexcept
-            {
-                return { x / other.x, y / other.y, z / other.z, w / other.w };
+            // First match in the code sections as an RVA, 0 when none (RVA 0 is the header, never code).
+            uint64_t find_rva(const Signature& sig) const {
+                if (!valid() || !sig.valid()) return 0;
+                for (const Range& r : code_ranges())
+                    if (uintptr_t addr = scan_range(r, sig)) return address_to_rva(addr);
+                return 0;
             }
 
-            Vector4 operator*(const float value) const noexcept
-            {
-                return { x * value, y * value, z * value, w * value };
+            size_t find_all_rvas(const Signature& sig, std::vector<uint64_t>& out, size_t max_count = SIZE_MAX) const {
+                size_t count = 0;
+                if (!valid() || !sig.valid()) return 0;
+                for (const Range& r : code_ranges()) {
+                    for (uintptr_t addr : FindAll(r, sig, max_count - count)) { out.push_back(address_to_rva(addr)); ++count; }
+                    if (count >= max_count) break;
+                }
+                return count;
             }
 
-            Vector4 operator/(const float value) const noexcept
-            {
-                return { x / value, y / value, z / value, w / value };
+            // Single sweep for a whole signature list; name → RVA (0 when not found).
+            std::map<std::string, uint64_t> find_rvas(const std::vector<NamedPattern>& patterns) const {
+                MultiPattern mp(patterns);
+                std::vector<uintptr_t> found(mp.size(), 0);
+                if (valid())
+                    for (const Range& r : code_ranges())
+                        if (mp.scan(r, found) == 0) break;
+                std::map<std::string, uint64_t> out;
+                for (size_t i = 0; i < mp.size(); ++i) out[mp.name(i)] = found[i] ? address_to_rva(found[i]) : 0;
+                return out;
             }
 
-            Vector4 WorldToScreen(const Matrix::Matrix4x4& viewMatrix, int windowWidth, int windowHeight) const noexcept
-            {
-                Vector4 clip;
-                clip.x = viewMatrix.m[0][0] * x + viewMatrix.m[0][1] * y + viewMatrix.m[0][2] * z + viewMatrix.m[0][3];
-                clip.y = viewMatrix.m[1][0] * x + viewMatrix.m[1][1] * y + viewMatrix.m[1][2] * z + viewMatrix.m[1][3];
-                clip.z = viewMatrix.m[2][0] * x + viewMatrix.m[2][1] * y + viewMatrix.m[2][2] * z + viewMatrix.m[2][3];
-                clip.w = viewMatrix.m[3][0] * x + viewMatrix.m[3][1] * y + viewMatrix.m[3][2] * z + viewMatrix.m[3][3];
+        private:
+            template<typename T>
+            bool read(uint64_t off, T& out) const {
+                if (off > file.size() || sizeof(T) > file.size() - off) return false;
+                std::memcpy(&out, file.data() + off, sizeof(T));
+                return true;
+            }
 
-                if (clip.w < 0.001f)
-                    return { -1, -1, 0, 0 }; // Behind the camera
+            uint64_t address_to_rva(uintptr_t addr) const {
+                const uint64_t rva = offset_to_rva(static_cast<uint64_t>(addr - reinterpret_cast<uintptr_t>(file.data())));
+                return rva == UINT64_MAX ? 0 : rva;
+            }
 
-                // Perspective divide → NDC
-                clip.x /= clip.w;
-                clip.y /= clip.w;
-                clip.z /= clip.w;
+            void add_section(ImageSection s) {
+                // Clamp to what the file really holds (truncated files, bss-like sections).
+                if (s.file_offset >= file.size()) s.file_size = 0;
+                else s.file_size = (std::min)(s.file_size, static_cast<uint64_t>(file.size()) - s.file_offset);
+                sections_.push_back(std::move(s));
+            }
 
-                // Map from NDC [-1, 1] → screen [0, width], [0, height]
-                Vector4 screen;
-                screen.x = (clip.x * 0.5f + 0.5f) * windowWidth;
-                screen.y = (1.0f - (clip.y * 0.5f + 0.5f)) * windowHeight; // Flip Y
-                screen.z = clip.z; // Depth (0..1)
-                screen.w = clip.w; // Keep original W if you need it later
-                return screen;
+            bool parse_pe() {
+                IMAGE_DOS_HEADER dos{};
+                if (!read(0, dos) || dos.e_magic != IMAGE_DOS_SIGNATURE) return false;
+                const uint64_t nt = static_cast<uint64_t>(static_cast<uint32_t>(dos.e_lfanew));
+                DWORD sig = 0;
+                IMAGE_FILE_HEADER fh{};
+                WORD magic = 0;
+                if (!read(nt, sig) || sig != IMAGE_NT_SIGNATURE || !read(nt + 4, fh)) { err = "Bad PE header"; return false; }
+                const uint64_t opt = nt + 4 + sizeof(IMAGE_FILE_HEADER);
+                if (!read(opt, magic)) { err = "Bad PE optional header"; return false; }
+                if (magic == IMAGE_NT_OPTIONAL_HDR64_MAGIC) {
+                    uint64_t ib = 0;
+                    if (!read(opt + 24, ib)) return false;
+                    base_va = ib; fmt = Format::PE64;
+                }
+                else if (magic == IMAGE_NT_OPTIONAL_HDR32_MAGIC) {
+                    uint32_t ib = 0;
+                    if (!read(opt + 28, ib)) return false;
+                    base_va = ib; fmt = Format::PE32;
+                }
+                else { err = "Unknown PE optional header magic"; return false; }
+
+                const uint64_t table = opt + fh.SizeOfOptionalHeader;
+                for (WORD i = 0; i < fh.NumberOfSections; ++i) {
+                    IMAGE_SECTION_HEADER sh{};
+                    if (!read(table + i * sizeof(IMAGE_SECTION_HEADER), sh)) { err = "Truncated section table"; fmt = Format::Unknown; return false; }
+                    ImageSection s;
+                    s.name.assign(reinterpret_cast<const char*>(sh.Name), strnlen(reinterpret_cast<const char*>(sh.Name), 8));
+                    s.rva = sh.VirtualAddress;
+                    s.virtual_size = sh.Misc.VirtualSize ? sh.Misc.VirtualSize : sh.SizeOfRawData;
+                    s.file_offset = sh.PointerToRawData;
+                    s.file_size = (std::min)(static_cast<uint64_t>(sh.SizeOfRawData), s.virtual_size);
+                    s.executable = (sh.Characteristics & (IMAGE_SCN_MEM_EXECUTE | IMAGE_SCN_CNT_CODE)) != 0;
+                    add_section(std::move(s));
+                }
+                return true;
             }
+
+            // ELF64 little-endian only; RVAs are relative to the lowest PT_LOAD address.
+            bool parse_elf() {
+                uint8_t ident[16] = {};
+                if (!read(0, ident) || std::memcmp(ident, "\x7F" "ELF", 4) != 0) return false;
+                if (ident[4] != 2 || ident[5] != 1) { err = "Only little-endian ELF64 is supported"; return false; }
+                uint64_t phoff = 0, shoff = 0;
+                uint16_t phentsize = 0, phnum = 0, shentsize = 0, shnum = 0, shstrndx = 0;
+                if (!read(32, phoff) || !read(40, shoff) || !read(54, phentsize) || !read(56, phnum) ||
+                    !read(58, shentsize) || !read(60, shnum) || !read(62, shstrndx)) { err = "Bad ELF header"; return false; }
+
+                uint64_t lowest = UINT64_MAX;
+                for (uint16_t i = 0; i < phnum && phentsize >= 56; ++i) {
+                    uint32_t type = 0; uint64_t vaddr = 0;
+                    if (!read(phoff + uint64_t(i) * phentsize, type) || !read(phoff + uint64_t(i) * phentsize + 16, vaddr)) break;
+                    if (type == 1 /*PT_LOAD*/) lowest = (std::min)(lowest, vaddr);
+                }
+                base_va = lowest == UINT64_MAX ? 0 : lowest;
+
+                if (shentsize < 64) { err = "Bad ELF section header size"; return false; }
+                uint64_t strtab = 0;
+                read(shoff + uint64_t(shstrndx) * shentsize + 24, strtab);
+                for (uint16_t i = 0; i < shnum; ++i) {
+                    const uint64_t sh = shoff + uint64_t(i) * shentsize;
+                    uint32_t name = 0, type = 0; uint64_t flags = 0, addr = 0, offset = 0, size = 0;
+                    if (!read(sh, name) || !read(sh + 4, type) || !read(sh + 8, flags) || !read(sh + 16, addr) ||
+                        !read(sh + 24, offset) || !read(sh + 32, size)) { err = "Truncated ELF section table"; return false; }
+                    if (!addr) continue; // not part of the loaded image
+                    ImageSection s;
+                    if (strtab + name < file.size()) {
+                        const char* p = reinterpret_cast<const char*>(file.data() + strtab + name);
+                        s.name.assign(p, strnlen(p, file.size() - (strtab + name)));
+                    }
+                    s.rva = addr - base_va;
+                    s.virtual_size = size;
+                    s.file_offset = offset;
+                    s.file_size = type == 8 /*SHT_NOBITS*/ ? 0 : size;
+                    s.executable = (flags & 0x4 /*SHF_EXECINSTR*/) != 0;
+                    add_section(std::move(s));
+                }
+                fmt = Format::ELF64;
+                return true;
+            }
+
+            MappedFile file;
+            Format fmt = Format::Unknown;
+            uint64_t base_va = 0;
+            std::vector<ImageSection> sections_;
+            std::string err;
         };
 
-        float GetDistance(const Vector3& src, const Vector3& dst)
+        // Checks a signature list against many builds at once, one file per worker.
+        // Result: path → (name → RVA, 0 when missing). Unreadable files map to an empty set.
+        // example: auto report = IMH::Scanner::scan_image_files({ "1.0/game.dll", "1.1/game.dll" }, sigs);
+        static std::map<std::string, std::map<std::string, uint64_t>> scan_image_files(
+            const std::vector<std::string>& paths, const std::vector<NamedPattern>& patterns)
         {
-            float dx = dst.x - src.x;
-            float dy = dst.y - src.y;
-            float dz = dst.z - src.z;
-            return sqrtf(dx * dx + dy * dy + dz * dz);
+            std::vector<std::map<std::string, uint64_t>> results(paths.size());
+            Helpers::DefaultPool().ParallelFor(paths.size(), [&](size_t i) {
+                ImageFile img(paths[i]);
+                if (img.valid()) results[i] = img.find_rvas(patterns);
+            });
+            std::map<std::string, std::map<std::string, uint64_t>> out;
+            for (size_t i = 0; i < paths.size(); ++i) out[paths[i]] = std::move(results[i]);
+            return out;
         }
 
-        Vector3 CalcAngles(Vector3 src, Vector3 dst)
-        {
-            Vector3 angles = {};
-            Vector3 delta = dst - src;
-            float distance = GetDistance(src, dst);
-
-            // Edge case: Avoid division by zero
-            if (distance < 0.001f) {
-                return Vector3(0.0f, 0.0f, 0.0f);
+        // ----------------------- Pointer-path scanning -----------------------
+        // A PointerMap is a snapshot of every aligned pointer-sized value in readable memory that
+        // points back into readable memory, sorted by value (value → address holding it), together
+        // with the module layout it was taken under. Paths are found backwards from the target:
+        // any holder whose value lies in [node - max_offset, node] is one hop further up, and the
+        // search stops at holders inside a module image. Maps can be saved and loaded so paths
+        // found in one session can be checked against snapshots from others.
+        // example: auto map = IMH::Scanner::PointerMap::capture();
+        //          auto paths = IMH::Scanner::find_pointer_paths(map, (uint64_t)&player->health);
+        //          uintptr_t hp = IMH::Utils::FindDMAAddy(paths[0].base(), paths[0].offsets);
+        struct PointerPath {
+            std::string module;               // module whose image holds the first pointer
+            uint64_t module_offset = 0;       // of that pointer from the module base
+            std::vector<unsigned int> offsets;// FindDMAAddy offsets, outermost first
+
+            // Absolute base for FindDMAAddy / Utils::PointerChain; 0 when the module is not loaded.
+            uintptr_t base() const {
+                HMODULE h = ModuleRegistry::instance().find_handle(module);
+                return h ? reinterpret_cast<uintptr_t>(h) + static_cast<uintptr_t>(module_offset) : 0;
             }
 
-            angles.x = -atan2f(delta.x, delta.y) * (180.0f / PI) + 180.0f;
+            uintptr_t resolve() const { return Utils::FindDMAAddy(base(), offsets); }
 
-            angles.y = asinf(delta.z / distance) * (180.0f / PI);
+            // e.g. "game.dll+0x1A2B30 -> 0x18 -> 0x40"
+            std::string to_string() const {
+                char buf[32];
+                snprintf(buf, sizeof(buf), "+0x%llX", static_cast<unsigned long long>(module_offset));
+                std::string s = module + buf;
+                for (unsigned int o : offsets) {
+                    snprintf(buf, sizeof(buf), " -> 0x%X", o);
+                    s += buf;
+                }
+                return s;
+            }
+        };
 
-            angles.z = 0.0f;
+        struct PointerScanOptions {
+            unsigned max_depth = 5;               // pointers dereferenced per path
+            uint32_t max_offset = 0x1000;         // largest offset added after a dereference
+            size_t max_nodes_per_level = 1 << 20; // caps how far each level may fan out
+            size_t max_results = 10000;
+        };
 
-            if (angles.x >= 360.0f) angles.x -= 360.0f;
-            if (angles.x < 0.0f) angles.x += 360.0f;
+        class PointerMap {
+        public:
+            struct Entry { uint64_t value; uint64_t holder; };
+            struct ModuleSpan { std::string name; uint64_t base; uint64_t size; };
+
+            // Walks all readable memory of this process in 1 MiB blocks on the worker pool; every
+            // block's hits are sorted where they were found and the runs merged pairwise. Blocks are
+            // copied with Memory::GuardedCopy first, so memory freed mid-capture is skipped, not read.
+            static PointerMap capture() {
+                PointerMap map;
+                for (const ModuleInfo& m : ModuleRegistry::instance().modules())
+                    map.mods.push_back({ m.name, reinterpret_cast<uint64_t>(m.handle), m.size });
+                std::sort(map.mods.begin(), map.mods.end(), [](const ModuleSpan& a, const ModuleSpan& b) { return a.base < b.base; });
+
+                const std::vector<Memory::Region> regions = Memory::GetLocalRegions(Memory::Readable);
+                if (regions.empty()) return map;
+                const uint64_t lowest = regions.front().base;
+                const uint64_t highest = regions.back().base + regions.back().size;
+                auto points_to_readable = [&](uint64_t v) {
+                    if (v < lowest || v >= highest) return false;
+                    auto it = std::upper_bound(regions.begin(), regions.end(), v,
+                        [](uint64_t x, const Memory::Region& r) { return x < r.base; });
+                    return it != regions.begin() && v < (it - 1)->base + (it - 1)->size;
+                };
 
-            return angles;
-        }
-    }
+                constexpr size_t block_bytes = size_t(1) << 20;
+                std::vector<Range> blocks;
+                for (const Memory::Region& r : regions)
+                    for (size_t off = 0; off < r.size; off += block_bytes)
+                        blocks.push_back({ reinterpret_cast<uint8_t*>(r.base + off), (std::min)(block_bytes, r.size - off) });
+
+                std::vector<std::vector<Entry>> runs(blocks.size());
+                Helpers::DefaultPool().ParallelFor(blocks.size(), [&](size_t i) {
+                    thread_local std::vector<uintptr_t> scratch;
+                    const Range& b = blocks[i];
+                    if (!Memory::IsRangeReadable(reinterpret_cast<uintptr_t>(b.base), b.size)) return;
+                    const size_t n = b.size / sizeof(uintptr_t);
+                    if (scratch.size() < n) scratch.resize(block_bytes / sizeof(uintptr_t));
+                    if (!Memory::GuardedCopy(scratch.data(), b.base, n * sizeof(uintptr_t))) return;
+                    const uintptr_t* p = scratch.data();
+                    const uint64_t holder = reinterpret_cast<uint64_t>(b.base);
+                    std::vector<Entry>& out = runs[i];
+                    for (size_t k = 0; k < n; ++k)
+                        if (points_to_readable(p[k]))
+                            out.push_back({ p[k], holder + k * sizeof(uintptr_t) });
+                    std::sort(out.begin(), out.end(), by_value);
+                });
+
+                runs.erase(std::remove_if(runs.begin(), runs.end(), [](const std::vector<Entry>& r) { return r.empty(); }), runs.end());
+                while (runs.size() > 1) {
+                    std::vector<std::vector<Entry>> merged((runs.size() + 1) / 2);
+                    Helpers::DefaultPool().ParallelFor(merged.size(), [&](size_t i) {
+                        if (2 * i + 1 == runs.size()) { merged[i] = std::move(runs[2 * i]); return; }
+                        const std::vector<Entry>& a = runs[2 * i];
+                        const std::vector<Entry>& b = runs[2 * i + 1];
+                        merged[i].resize(a.size() + b.size());
+                        std::merge(a.begin(), a.end(), b.begin(), b.end(), merged[i].begin(), by_value);
+                        runs[2 * i] = {};
+                        runs[2 * i + 1] = {};
+                    });
+                    runs = std::move(merged);
+                }
+                if (!runs.empty()) map.list = std::move(runs.front());
+                return map;
+            }
 
-    namespace Scanner
-    {
-        // ----------------------- ASCII pattern compiler -----------------------
-        static inline int hexval(char c) {
-            if (c >= '0' && c <= '9') return c - '0';
-            c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
-            if (c >= 'A' && c <= 'F') return 10 + (c - 'A');
-            return -1;
-        }
-        static void push_byte_token(const std::string& tok, std::vector<uint8_t>& pat, std::vector<uint8_t>& mask) {
-            if (tok == "?" || tok == "??") { pat.push_back(0x00); mask.push_back(0x00); return; }
-            if (tok.size() != 2) throw std::runtime_error("Bad token: " + tok);
-            const char hi = tok[0], lo = tok[1];
-            uint8_t p = 0, m = 0;
-            if (hi == '?') { /* upper wildcard */ }
-            else {
-                int v = hexval(hi); if (v < 0) throw std::runtime_error("Bad hex: " + tok);
-                p |= static_cast<uint8_t>(v << 4); m |= 0xF0;
+            const std::vector<Entry>& entries() const { return list; }
+            const std::vector<ModuleSpan>& modules() const { return mods; }
+            size_t size() const { return list.size(); }
+
+            // Module image containing addr, nullptr for heap/stack/anonymous memory.
+            const ModuleSpan* module_of(uint64_t addr) const {
+                auto it = std::upper_bound(mods.begin(), mods.end(), addr, [](uint64_t x, const ModuleSpan& m) { return x < m.base; });
+                if (it == mods.begin()) return nullptr;
+                --it;
+                return addr < it->base + it->size ? &*it : nullptr;
             }
-            if (lo == '?') { /* lower wildcard */ }
-            else {
-                int v = hexval(lo); if (v < 0) throw std::runtime_error("Bad hex: " + tok);
-                p |= static_cast<uint8_t>(v & 0x0F); m |= 0x0F;
+
+            const ModuleSpan* find_module(std::string_view name) const {
+                for (const ModuleSpan& m : mods) if (iequals(m.name, name)) return &m;
+                return nullptr;
             }
-            pat.push_back(p); mask.push_back(m);
-        }
-        struct MaskedPattern {
-            const uint8_t* pat;
-            const uint8_t* mask; // per-byte bitmask (0xFF exact, 0xF0 upper-only, 0x0F lower-only, 0x00 wildcard)
-            size_t len;
-        };
-        static MaskedPattern compile_ascii_pattern(const std::string& ascii,
-            std::vector<uint8_t>& pat_out,
-            std::vector<uint8_t>& mask_out)
-        {
-            pat_out.clear(); mask_out.clear();
-            std::string tok; tok.reserve(4);
-            for (size_t i = 0; i < ascii.size();) {
-                while (i < ascii.size() && std::isspace(static_cast<unsigned char>(ascii[i]))) ++i;
-                if (i >= ascii.size()) break;
-                size_t j = i;
-                while (j < ascii.size() && !std::isspace(static_cast<unsigned char>(ascii[j]))) ++j;
-                tok = ascii.substr(i, j - i);
-                for (char& c : tok) c = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
-                push_byte_token(tok, pat_out, mask_out);
-                i = j;
+
+            // fn(entry) for every pointer whose value lies in [lo, hi], in value order.
+            template <typename F>
+            void for_each_in(uint64_t lo, uint64_t hi, F&& fn) const {
+                auto it = std::lower_bound(list.begin(), list.end(), lo, [](const Entry& e, uint64_t v) { return e.value < v; });
+                for (; it != list.end() && it->value <= hi; ++it) fn(*it);
             }
-            if (pat_out.empty()) throw std::runtime_error("Empty ASCII pattern");
-            return MaskedPattern{ pat_out.data(), mask_out.data(), pat_out.size() };
-        }
 
-        // ----------------------- Horspool (wildcard-aware) -----------------------
-        static size_t find_horspool_masked(const uint8_t* hay, size_t n, const MaskedPattern& mp) {
-            const size_t m = mp.len;
-            if (!m || n < m) return n;
-            // Tail: last fully-known byte (mask 0xFF)
-            ptrdiff_t tail = -1;
-            for (ptrdiff_t i = (ptrdiff_t)m - 1; i >= 0; --i) if (mp.mask[i] == 0xFF) { tail = i; break; }
+            // Layout: magic, version, module count, entry count, modules (u16 name length, name, base,
+            // size), then per entry LEB128(value delta) and LEB128(zig-zag holder delta). Values are
+            // sorted, so that typically takes 6-8 bytes per entry instead of 16.
+            bool save(const std::string& path) const {
+                std::string buf(file_magic, sizeof(file_magic));
+                auto put = [&](const void* p, size_t n) { buf.append(static_cast<const char*>(p), n); };
+                const uint32_t module_count = static_cast<uint32_t>(mods.size());
+                const uint64_t entry_count = list.size();
+                put(&file_version, sizeof(file_version));
+                put(&module_count, sizeof(module_count));
+                put(&entry_count, sizeof(entry_count));
+                for (const ModuleSpan& m : mods) {
+                    const uint16_t len = static_cast<uint16_t>((std::min)(m.name.size(), size_t(0xFFFF)));
+                    put(&len, sizeof(len));
+                    put(m.name.data(), len);
+                    put(&m.base, sizeof(m.base));
+                    put(&m.size, sizeof(m.size));
+                }
+                buf.reserve(buf.size() + list.size() * 8);
+                uint64_t prev_value = 0, prev_holder = 0;
+                for (const Entry& e : list) {
+                    put_varint(buf, e.value - prev_value);
+                    const int64_t d = static_cast<int64_t>(e.holder - prev_holder);
+                    put_varint(buf, (static_cast<uint64_t>(d) << 1) ^ static_cast<uint64_t>(d >> 63));
+                    prev_value = e.value;
+                    prev_holder = e.holder;
+                }
 
-            if (tail < 0) { // no concrete anchor → linear masked compare
-                for (size_t pos = 0; pos <= n - m; ++pos) {
-                    size_t j = 0;
-                    for (; j < m; ++j) if (((hay[pos + j] ^ mp.pat[j]) & mp.mask[j]) != 0) break;
-                    if (j == m) return pos;
+                const std::string tmp = path + ".tmp";
+                {
+                    std::ofstream f(tmp, std::ios::binary | std::ios::trunc);
+                    if (!f) return false;
+                    f.write(buf.data(), static_cast<std::streamsize>(buf.size()));
+                    if (!f) return false;
                 }
-                return n;
+                return MoveFileExA(tmp.c_str(), path.c_str(), MOVEFILE_REPLACE_EXISTING) != FALSE;
             }
 
-            std::array<size_t, 256> shift;
-            shift.fill(static_cast<size_t>(tail + 1));
-            for (size_t i = 0; i < static_cast<size_t>(tail); ++i)
-                if (mp.mask[i] == 0xFF) shift[mp.pat[i]] = static_cast<size_t>(tail - i);
+            static bool load(const std::string& path, PointerMap& out) {
+                MappedFile file(path);
+                if (!file.valid()) return false;
+                const uint8_t* p = file.data();
+                const uint8_t* const end = p + file.size();
+                auto get = [&](void* dst, size_t n) {
+                    if (static_cast<size_t>(end - p) < n) return false;
+                    std::memcpy(dst, p, n);
+                    p += n;
+                    return true;
+                };
 
-            size_t pos = 0;
-            while (pos <= n - m) {
-                const uint8_t h = hay[pos + tail];
-                if (h == mp.pat[tail]) {
-                    ptrdiff_t j = (ptrdiff_t)m - 1;
-                    for (; j >= 0; --j)
-                        if (((hay[pos + j] ^ mp.pat[j]) & mp.mask[j]) != 0) break;
-                    if (j < 0) return pos;
+                char magic[8] = {};
+                uint32_t version = 0, module_count = 0;
+                uint64_t entry_count = 0;
+                if (!get(magic, sizeof(magic)) || std::memcmp(magic, file_magic, sizeof(magic)) != 0) return false;
+                if (!get(&version, sizeof(version)) || version != file_version) return false;
+                if (!get(&module_count, sizeof(module_count)) || !get(&entry_count, sizeof(entry_count))) return false;
+                // every entry takes at least two bytes; rejects corrupt counts before reserving
+                if (entry_count > static_cast<uint64_t>(end - p) / 2) return false;
+
+                PointerMap map;
+                for (uint32_t i = 0; i < module_count; ++i) {
+                    uint16_t len = 0;
+                    ModuleSpan m;
+                    if (!get(&len, sizeof(len)) || static_cast<size_t>(end - p) < len) return false;
+                    m.name.assign(reinterpret_cast<const char*>(p), len);
+                    p += len;
+                    if (!get(&m.base, sizeof(m.base)) || !get(&m.size, sizeof(m.size))) return false;
+                    map.mods.push_back(std::move(m));
                 }
-                pos += shift[h];
+                std::sort(map.mods.begin(), map.mods.end(), [](const ModuleSpan& a, const ModuleSpan& b) { return a.base < b.base; });
+
+                map.list.resize(static_cast<size_t>(entry_count));
+                uint64_t value = 0, holder = 0;
+                for (Entry& e : map.list) {
+                    uint64_t dv = 0, dh = 0;
+                    if (!get_varint(p, end, dv) || !get_varint(p, end, dh)) return false;
+                    value += dv;
+                    holder += (dh >> 1) ^ (0 - (dh & 1));
+                    e = { value, holder };
+                }
+                out = std::move(map);
+                return true;
             }
-            return n;
-        }
 
-        // ----------------------- PE helpers (.text range) -----------------------
-        struct Range { uint8_t* base; size_t size; };
-        static bool get_text_range(HMODULE mod, Range& out) {
-            auto base = reinterpret_cast<uint8_t*>(mod);
-            auto dos = reinterpret_cast<IMAGE_DOS_HEADER*>(base);
-            if (!dos || dos->e_magic != IMAGE_DOS_SIGNATURE) return false;
-            auto nt = reinterpret_cast<IMAGE_NT_HEADERS*>(base + dos->e_lfanew);
-            if (!nt || nt->Signature != IMAGE_NT_SIGNATURE) return false;
+        private:
+            static constexpr char file_magic[8] = { 'I', 'M', 'H', 'P', 'T', 'R', 'M', '1' };
+            static constexpr uint32_t file_version = 1;
 
-            auto sect = IMAGE_FIRST_SECTION(nt);
-            for (WORD i = 0; i < nt->FileHeader.NumberOfSections; ++i) {
-                const IMAGE_SECTION_HEADER& s = sect[i];
-                // section name is not null-terminated; compare up to 8
-                if (std::equal(std::begin(".text"), std::end(".text") - 1, reinterpret_cast<const char*>(s.Name))) {
-                    out.base = base + s.VirtualAddress;
-                    out.size = s.Misc.VirtualSize ? s.Misc.VirtualSize : s.SizeOfRawData;
-                    return true;
-                }
+            static bool by_value(const Entry& a, const Entry& b) {
+                return a.value != b.value ? a.value < b.value : a.holder < b.holder;
             }
-            // fallback: whole image (less efficient, but keeps working)
-            out.base = base;
-            out.size = nt->OptionalHeader.SizeOfImage;
-            return true;
-        }
-
-        // ----------------------- Module enumeration -----------------------
-        static bool iequals(std::string a, std::string b) {
-            if (a.size() != b.size()) return false;
-            for (size_t i = 0; i < a.size(); ++i)
-                if (std::toupper((unsigned char)a[i]) != std::toupper((unsigned char)b[i])) return false;
-            return true;
-        }
-        static std::string filename_only(const std::string& path) {
-            const char* sep = "\\/";
-            size_t pos = path.find_last_of(sep);
-            return (pos == std::string::npos) ? path : path.substr(pos + 1);
-        }
 
-        // ----------------------- Core scanning -----------------------
-        static uintptr_t scan_range(const Range& r, const std::string& ascii) {
-            std::vector<uint8_t> pat, mask;
-            auto mp = compile_ascii_pattern(ascii, pat, mask);
-            size_t off = find_horspool_masked(r.base, r.size, mp);
-            return (off == r.size) ? 0 : (reinterpret_cast<uintptr_t>(r.base) + off);
-        }
+            static void put_varint(std::string& buf, uint64_t v) {
+                for (; v >= 0x80; v >>= 7) buf.push_back(static_cast<char>(v | 0x80));
+                buf.push_back(static_cast<char>(v));
+            }
 
-        static uintptr_t scan_module(HMODULE mod, const std::string& ascii) {
-            Range r{};
-            if (!get_text_range(mod, r)) return 0;
-            return scan_range(r, ascii);
-        }
+            static bool get_varint(const uint8_t*& p, const uint8_t* end, uint64_t& v) {
+                v = 0;
+                for (unsigned shift = 0; p < end && shift < 64; shift += 7) {
+                    const uint8_t b = *p++;
+                    v |= uint64_t(b & 0x7F) << shift;
+                    if (!(b & 0x80)) return true;
+                }
+                return false;
+            }
 
-        static uintptr_t scan_all_modules(const std::string& ascii) {
-            HANDLE proc = GetCurrentProcess();
-            HMODULE mods[1024];
-            DWORD cbNeeded = 0;
-            if (!EnumProcessModules(proc, mods, sizeof(mods), &cbNeeded)) return 0;
-            const size_t count = cbNeeded / sizeof(HMODULE);
+            std::vector<Entry> list;       // sorted by value
+            std::vector<ModuleSpan> mods;  // sorted by base
+        };
 
-            // First: main module
-            if (count > 0) {
-                if (auto addr = scan_module(mods[0], ascii)) return addr;
-            }
-            // Then: the rest
-            for (size_t i = 1; i < count; ++i) {
-                if (auto addr = scan_module(mods[i], ascii)) return addr;
+        // Reverse breadth-first search from target towards module-relative bases. Heap addresses are
+        // expanded once, at their shallowest depth; a static base yields every path length it is
+        // reachable with. Each level is searched in parallel and merged in order, so results are
+        // deterministic.
+        static std::vector<PointerPath> find_pointer_paths(const PointerMap& map, uint64_t target,
+                                                           const PointerScanOptions& opt = {})
+        {
+            struct Node { uint64_t addr; uint32_t level; bool is_static; };
+            struct Edge { uint32_t from; uint32_t to; uint32_t offset; };   // from holds a pointer to to - offset
+            struct Hit { uint64_t holder; uint32_t to; uint32_t offset; };
+
+            std::vector<Node> nodes{ { target, 0, false } };
+            std::vector<Edge> edges;
+            std::unordered_map<uint64_t, uint32_t> seen{ { target, 0 } };
+            std::vector<uint32_t> frontier{ 0 };
+            std::vector<uint32_t> statics;
+
+            constexpr size_t nodes_per_task = 256;
+            for (uint32_t level = 0; level < opt.max_depth && !frontier.empty(); ++level) {
+                std::vector<std::vector<Hit>> hits((frontier.size() + nodes_per_task - 1) / nodes_per_task);
+                Helpers::DefaultPool().ParallelFor(hits.size(), [&](size_t t) {
+                    const size_t last = (std::min)(frontier.size(), (t + 1) * nodes_per_task);
+                    for (size_t k = t * nodes_per_task; k < last; ++k) {
+                        const uint64_t addr = nodes[frontier[k]].addr;
+                        const uint64_t lo = addr > opt.max_offset ? addr - opt.max_offset : 0;
+                        map.for_each_in(lo, addr, [&](const PointerMap::Entry& e) {
+                            hits[t].push_back({ e.holder, frontier[k], static_cast<uint32_t>(addr - e.value) });
+                        });
+                    }
+                });
+
+                std::vector<uint32_t> next;
+                for (const std::vector<Hit>& task : hits) {
+                    for (const Hit& h : task) {
+                        auto it = seen.find(h.holder);
+                        if (it == seen.end()) {
+                            if (next.size() >= opt.max_nodes_per_level) continue;
+                            const uint32_t id = static_cast<uint32_t>(nodes.size());
+                            const bool is_static = map.module_of(h.holder) != nullptr;
+                            nodes.push_back({ h.holder, level + 1, is_static });
+                            it = seen.emplace(h.holder, id).first;
+                            if (is_static) statics.push_back(id);
+                            else next.push_back(id);
+                        }
+                        // Statics are never expanded, so they may start paths of any length;
+                        // other nodes only link to the level below, which keeps the graph acyclic.
+                        const Node& from = nodes[it->second];
+                        if (from.is_static || from.level == level + 1)
+                            edges.push_back({ it->second, h.to, h.offset });
+                    }
+                }
+                frontier = std::move(next);
             }
-            return 0;
-        }
-
-        static HMODULE find_module_by_name(std::string name) {
-            if (name == "" || iequals(name, "exe") || iequals(name, "self")) return GetModuleHandleW(nullptr);
 
-            HANDLE proc = GetCurrentProcess();
-            HMODULE mods[1024];
-            DWORD cbNeeded = 0;
-            if (!EnumProcessModules(proc, mods, sizeof(mods), &cbNeeded)) return nullptr;
-            const size_t count = cbNeeded / sizeof(HMODULE);
+            // Enumerate static → … → target along the recorded edges.
+            std::stable_sort(edges.begin(), edges.end(), [](const Edge& a, const Edge& b) { return a.from < b.from; });
+            auto edges_of = [&](uint32_t from) {
+                auto lo = std::lower_bound(edges.begin(), edges.end(), from, [](const Edge& e, uint32_t v) { return e.from < v; });
+                auto hi = std::upper_bound(lo, edges.end(), from, [](uint32_t v, const Edge& e) { return v < e.from; });
+                return std::make_pair(lo, hi);
+            };
 
-            std::string want = filename_only(name);
-            for (size_t i = 0; i < count; ++i) {
-                char path[MAX_PATH] = {};
-                if (GetModuleFileNameExA(proc, mods[i], path, MAX_PATH)) {
-                    std::string file = filename_only(path);
-                    if (iequals(file, want)) return mods[i];
+            std::vector<PointerPath> out;
+            std::vector<unsigned int> offsets;
+            const PointerMap::ModuleSpan* mod = nullptr;
+            uint64_t base = 0;
+            std::function<void(uint32_t)> walk = [&](uint32_t node) {
+                if (node == 0) {
+                    out.push_back({ mod->name, base - mod->base, offsets });
+                    return;
+                }
+                auto [lo, hi] = edges_of(node);
+                for (auto it = lo; it != hi && out.size() < opt.max_results; ++it) {
+                    offsets.push_back(it->offset);
+                    walk(it->to);
+                    offsets.pop_back();
                 }
+            };
+            for (uint32_t s : statics) {
+                if (out.size() >= opt.max_results) break;
+                base = nodes[s].addr;
+                mod = map.module_of(base);
+                walk(s);
             }
-            // Also allow GetModuleHandleA if it's already loaded by that exact name
-            if (HMODULE h = GetModuleHandleA(want.c_str())) return h;
-            return nullptr;
+            return out;
         }
 
-        // ----------------------- Public API (your two overloads) -----------------------
-
-        // example : void* addr = reinterpret_cast<void*>(IMH::Scanner::patternscan("48 8B ?? ?? ?? ?? ?? 48 85 C0 74 0A"));
-        // example2: void* addr2 = reinterpret_cast<void*>(IMH::Scanner::patternscan("example.dll", "48 8B ?? ?? ?? ?? ?? 48 85 C0 74 0A"));
-
-        inline uintptr_t patternscan(const char* ascii_pattern) {
-            if (!ascii_pattern) return 0;
-            try { return scan_all_modules(ascii_pattern); }
-            catch (...) { return 0; }
+        // Snapshot the current process and search it.
+        static std::vector<PointerPath> find_pointer_paths(uintptr_t target, const PointerScanOptions& opt = {}) {
+            return find_pointer_paths(PointerMap::capture(), static_cast<uint64_t>(target), opt);
         }
 
-        inline uintptr_t patternscan(const char* module_name, const char* ascii_pattern) {
-            if (!ascii_pattern) return 0;
-            try {
-                HMODULE mod = find_module_by_name(module_name ? module_name : "");
-                if (!mod) return 0;
-                return scan_module(mod, ascii_pattern);
-            }
-            catch (...) { return 0; }
-        }
+        // Keeps the paths that also reach target in another snapshot (another session, after a
+        // restart or level change), following them through that snapshot's map and module bases.
+        // Intersecting two or three snapshots usually leaves only the stable paths.
+        static std::vector<PointerPath> filter_pointer_paths(const std::vector<PointerPath>& paths,
+                                                             const PointerMap& snapshot, uint64_t target)
+        {
+            std::vector<PointerMap::Entry> by_holder = snapshot.entries();
+            std::sort(by_holder.begin(), by_holder.end(), [](const PointerMap::Entry& a, const PointerMap::Entry& b) { return a.holder < b.holder; });
+            auto value_at = [&](uint64_t holder, uint64_t& value) {
+                auto it = std::lower_bound(by_holder.begin(), by_holder.end(), holder,
+                    [](const PointerMap::Entry& e, uint64_t h) { return e.holder < h; });
+                if (it == by_holder.end() || it->holder != holder) return false;
+                value = it->value;
+                return true;
+            };
 
-        inline uintptr_t patternscan(void* base, size_t size, const char* ascii_pattern) {
-            if (!base || !size || !ascii_pattern) return 0;
-            try {
-                Range r{};
-                r.base = static_cast<uint8_t*>(base);
-                r.size = size;
-                return scan_range(r, ascii_pattern);
-            }
-            catch (...) {
-                return 0;
+            std::vector<PointerPath> out;
+            for (const PointerPath& p : paths) {
+                const PointerMap::ModuleSpan* mod = snapshot.find_module(p.module);
+                if (!mod || p.offsets.empty()) continue;
+                uint64_t addr = mod->base + p.module_offset;
+                bool ok = true;
+                for (unsigned int o : p.offsets) {
+                    uint64_t value = 0;
+                    if (!value_at(addr, value)) { ok = false; break; }
+                    addr = value + o;
+                }
+                if (ok && addr == target) out.push_back(p);
             }
+            return out;
         }
     }
 }
@@ -983,6 +6227,7 @@ typedef struct _MonoMethodSignature  MonoMethodSignature;
 typedef struct _MonoVTable           MonoVTable;
 typedef struct _MonoClassField       MonoClassField;
 typedef struct _MonoProperty         MonoProperty;
+typedef uint16_t                      mono_unichar2;
 typedef void* gpointer;
 
 // -------- mono api typedefs (core) --------
@@ -1027,6 +6272,8 @@ typedef MonoObject* (*mono_object_new_t)(MonoDomain*, MonoClass*);
 typedef void        (*mono_runtime_object_init_t)(MonoObject*);
 typedef MonoString* (*mono_string_new_t)(MonoDomain*, const char*);
 typedef char* (*mono_string_to_utf8_t)(MonoString*);
+typedef mono_unichar2* (*mono_string_chars_t)(MonoString*);
+typedef int32_t     (*mono_string_length_t)(MonoString*);
 typedef void        (*mono_free_t)(void*);
 typedef MonoClass* (*mono_object_get_class_t)(MonoObject*);
 typedef MonoString* (*mono_object_to_string_t)(MonoObject*, MonoObject**);
@@ -1097,6 +6344,8 @@ namespace IMH
             mono_runtime_object_init_t          mono_runtime_object_init{};
             mono_string_new_t                   mono_string_new{};
             mono_string_to_utf8_t               mono_string_to_utf8{};
+            mono_string_chars_t                 mono_string_chars{};
+            mono_string_length_t                mono_string_length{};
             mono_free_t                         mono_free{};
             mono_object_get_class_t             mono_object_get_class{};
             mono_object_to_string_t             mono_object_to_string{};
@@ -1215,6 +6464,8 @@ namespace IMH
                 gp(mono_runtime_object_init, "mono_runtime_object_init");
                 gp(mono_string_new, "mono_string_new");
                 gp(mono_string_to_utf8, "mono_string_to_utf8");
+                gp(mono_string_chars, "mono_string_chars");
+                gp(mono_string_length, "mono_string_length");
                 gp(mono_free, "mono_free");
                 gp(mono_object_get_class, "mono_object_get_class");
                 gp(mono_object_to_string, "mono_object_to_string");
@@ -1598,9 +6849,19 @@ namespace IMH
                 return mono_string_new(ActiveDomain(), utf8);
             }
 
+            // Transcodes the UTF-16 payload in place when chars/length are exported; otherwise
+            // falls back to mono_string_to_utf8 (runtime allocation + mono_free)
             std::string ToUtf8(MonoString* s)
             {
-                if (!s || !mono_string_to_utf8) return std::string();
+                if (!s) return std::string();
+                if (mono_string_chars && mono_string_length)
+                {
+                    const int32_t len = mono_string_length(s);
+                    const mono_unichar2* chars = mono_string_chars(s);
+                    if (!chars || len <= 0) return std::string();
+                    return IMH::String::Utf16ToUtf8(std::u16string_view(reinterpret_cast<const char16_t*>(chars), static_cast<size_t>(len)));
+                }
+                if (!mono_string_to_utf8) return std::string();
                 char* p = mono_string_to_utf8(s);
                 if (!p) return std::string();
                 std::string out = p;